@@ -0,0 +1,188 @@
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include <utility>
+
+#include "automorphism.hpp"
+
+Automorphisms::Automorphisms(const Graph& g, long max_nodes) {
+
+    this->n = g.vs();
+    this->m = g.adjmat();
+    this->nodes = 0;
+    this->max_nodes = max_nodes;
+
+    this->adj.resize(this->n);
+    for(int v1 = 0; v1 < this->n; v1++)
+        for(int v2 = 0; v2 < this->n; v2++)
+            if(this->m[v1][v2] == 1)
+                this->adj[v1].push_back(v2);
+
+    // the leftmost path always individualizes the lowest vertex of the cell
+    std::vector<int> colors = this->refine(std::vector<int>(this->n, 0));
+    for(;;) {
+        this->path.push_back(colors);
+        this->shapes.push_back(this->shape(colors));
+
+        int t = this->target_cell(colors);
+        if(t == -1)
+            break;
+
+        int v = 0;
+        while(colors[v] != t)
+            v++;
+        this->chosen.push_back(v);
+        colors = this->refine(this->individualize(colors, v));
+    }
+
+    // orbits of the group generated so far, as a union-find forest
+    std::vector<int> orbit(this->n);
+    std::iota(orbit.begin(), orbit.end(), 0);
+    auto find = [&](int v) {
+        while(orbit[v] != v)
+            v = orbit[v] = orbit[orbit[v]];
+        return v;
+    };
+
+    // deepest level first: the generators found below level l fix every
+    // vertex chosen above it, so their orbits are orbits of the stabilizer
+    for(int l = (int)this->chosen.size() - 1; l >= 0 && this->nodes < this->max_nodes; l--) {
+
+        int v = this->chosen[l];
+        const std::vector<int>& above = this->path[l];
+
+        for(int w = 0; w < this->n && this->nodes < this->max_nodes; w++) {
+
+            if(above[w] != above[v] || find(w) == find(v))
+                continue;
+
+            std::vector<int> below = this->refine(this->individualize(above, w));
+            if(this->shape(below) != this->shapes[l + 1])
+                continue;
+
+            std::vector<int> perm;
+            if(!this->search(below, l + 1, perm))
+                continue;
+
+            this->gens.push_back(perm);
+            for(int u = 0; u < this->n; u++)
+                orbit[find(u)] = find(perm[u]);
+        }
+    }
+}
+
+std::vector<int> Automorphisms::refine(std::vector<int> colors) const {
+
+    // Split cells by the multiset of neighbor colors until nothing splits.
+    // New colors are ranks of (old color, neighbor colors), which keeps the
+    // order of the cells and does not depend on the vertex numbering.
+    if(this->n == 0)
+        return colors;
+
+    std::vector<std::pair<int, std::vector<int>>> signature(this->n);
+    std::vector<int> order(this->n);
+
+    int cells = *std::max_element(colors.begin(), colors.end()) + 1;
+    for(;;) {
+
+        pthread_testcancel();
+
+        for(int v = 0; v < this->n; v++) {
+            signature[v].first = colors[v];
+            signature[v].second.clear();
+            for(int u: this->adj[v])
+                signature[v].second.push_back(colors[u]);
+            std::sort(signature[v].second.begin(), signature[v].second.end());
+        }
+
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return signature[a] < signature[b];
+        });
+
+        int rank = 0;
+        for(int i = 0; i < this->n; i++) {
+            if(i > 0 && signature[order[i]] != signature[order[i - 1]])
+                rank++;
+            colors[order[i]] = rank;
+        }
+
+        if(rank + 1 == cells)
+            return colors;
+        cells = rank + 1;
+    }
+}
+
+std::vector<int> Automorphisms::individualize(const std::vector<int>& colors, int v) const {
+
+    // v goes first in its cell; every later cell moves up by one
+    std::vector<int> split(this->n);
+    for(int u = 0; u < this->n; u++)
+        split[u] = colors[u] + (colors[u] > colors[v] || (colors[u] == colors[v] && u != v));
+    return split;
+}
+
+std::vector<int> Automorphisms::shape(const std::vector<int>& colors) const {
+
+    std::vector<int> sizes(this->n, 0);
+    for(int c: colors)
+        sizes[c]++;
+    return sizes;
+}
+
+int Automorphisms::target_cell(const std::vector<int>& colors) const {
+
+    std::vector<int> sizes = this->shape(colors);
+    for(int c = 0; c < this->n; c++)
+        if(sizes[c] > 1)
+            return c;
+    return -1;
+}
+
+bool Automorphisms::is_automorphism(const std::vector<int>& perm) const {
+
+    for(int v = 0; v < this->n; v++)
+        for(int u: this->adj[v])
+            if(this->m[perm[v]][perm[u]] != 1)
+                return false;
+    return true;
+}
+
+bool Automorphisms::search(const std::vector<int>& colors, size_t level, std::vector<int>& perm) {
+
+    this->nodes++;
+
+    int t = this->target_cell(colors);
+    if(t == -1) {
+        // both leaves are discrete: map each vertex of the reference leaf to
+        // the vertex with the same color here
+        const std::vector<int>& reference = this->path.back();
+        std::vector<int> at(this->n);
+        for(int u = 0; u < this->n; u++)
+            at[colors[u]] = u;
+
+        perm.resize(this->n);
+        for(int v = 0; v < this->n; v++)
+            perm[v] = at[reference[v]];
+
+        return this->is_automorphism(perm);
+    }
+
+    for(int u = 0; u < this->n && this->nodes < this->max_nodes; u++) {
+
+        if(colors[u] != t)
+            continue;
+
+        std::vector<int> below = this->refine(this->individualize(colors, u));
+        if(this->shape(below) != this->shapes[level + 1])
+            continue;
+
+        if(this->search(below, level + 1, perm))
+            return true;
+    }
+
+    return false;
+}
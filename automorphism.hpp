@@ -0,0 +1,56 @@
+
+#ifndef _AUTOMORPHISM_HPP
+#define _AUTOMORPHISM_HPP
+
+#include <vector>
+
+#include "graph.hpp"
+
+// Generators of the automorphism group of a graph, found by individualization
+// and refinement in the manner of nauty. Colors are refined until equitable
+// and the search tree individualizes a vertex of the first non-singleton cell
+// per level. The leftmost leaf is the reference: for every level, deepest
+// first, and every vertex w of that level's cell that is not yet in the orbit
+// of the leftmost choice v, a leaf under w is looked for whose labeling maps
+// the reference onto an automorphism taking v to w. The search stops after
+// max_nodes tree nodes; every generator it returns is an automorphism.
+class Automorphisms {
+
+    private:
+
+        int n;
+        std::vector<std::vector<int>> adj;
+        int **m;
+
+        long nodes;
+        long max_nodes;
+
+        // the leftmost path: partition and individualized vertex per level
+        std::vector<std::vector<int>> path;
+        std::vector<int> chosen;
+        std::vector<std::vector<int>> shapes;
+
+        std::vector<std::vector<int>> gens;
+
+        std::vector<int> refine(std::vector<int> colors) const;
+        std::vector<int> individualize(const std::vector<int>& colors, int v) const;
+        std::vector<int> shape(const std::vector<int>& colors) const;
+        int target_cell(const std::vector<int>& colors) const;
+        bool is_automorphism(const std::vector<int>& perm) const;
+        bool search(const std::vector<int>& colors, size_t level, std::vector<int>& perm);
+
+    public:
+
+        Automorphisms(const Graph& g, long max_nodes = 100000);
+
+        // permutations perm with perm[v] the image of v
+        const std::vector<std::vector<int>>& generators() const {
+            return this->gens;
+        }
+
+        long explored() const {
+            return this->nodes;
+        }
+};
+
+#endif
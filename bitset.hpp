@@ -0,0 +1,91 @@
+
+#ifndef _BITSET_HPP
+#define _BITSET_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <vector>
+
+// Fixed-size set of vertices packed into 64-bit words.
+class Bitset {
+
+    private:
+
+        std::vector<uint64_t> w;
+
+    public:
+
+        Bitset() {}
+        Bitset(int n): w((n + 63) / 64, 0) {}
+
+        void set(int v) {
+            this->w[v >> 6] |= (uint64_t)1 << (v & 63);
+        }
+
+        void reset(int v) {
+            this->w[v >> 6] &= ~((uint64_t)1 << (v & 63));
+        }
+
+        bool test(int v) const {
+            return (this->w[v >> 6] >> (v & 63)) & 1;
+        }
+
+        int count() const {
+            int c = 0;
+            for(uint64_t x: this->w)
+                c += __builtin_popcountll(x);
+            return c;
+        }
+
+        // |this & other| without materializing the intersection
+        int count_and(const Bitset& other) const {
+            int c = 0;
+            for(size_t i = 0; i < this->w.size(); i++)
+                c += __builtin_popcountll(this->w[i] & other.w[i]);
+            return c;
+        }
+
+        bool any() const {
+            for(uint64_t x: this->w)
+                if(x)
+                    return true;
+            return false;
+        }
+
+        // lowest member of this & other, -1 if there is none
+        int first_and(const Bitset& other) const {
+            for(size_t i = 0; i < this->w.size(); i++) {
+                uint64_t x = this->w[i] & other.w[i];
+                if(x)
+                    return i * 64 + __builtin_ctzll(x);
+            }
+            return -1;
+        }
+
+        Bitset& operator&=(const Bitset& other) {
+            for(size_t i = 0; i < this->w.size(); i++)
+                this->w[i] &= other.w[i];
+            return *this;
+        }
+
+        Bitset& operator-=(const Bitset& other) {
+            for(size_t i = 0; i < this->w.size(); i++)
+                this->w[i] &= ~other.w[i];
+            return *this;
+        }
+
+        // calls f(v) for every member in increasing order
+        template<typename F>
+        void for_each(F f) const {
+            for(size_t i = 0; i < this->w.size(); i++) {
+                uint64_t x = this->w[i];
+                while(x) {
+                    f((int)(i * 64 + __builtin_ctzll(x)));
+                    x &= x - 1;
+                }
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,197 @@
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "bnb.hpp"
+
+BranchAndBound::BranchAndBound(const Graph& g) {
+
+    this->n = g.vs();
+    this->nodes = 0;
+
+    int **m = g.adjmat();
+    this->nb.assign(this->n, Bitset(this->n));
+    for(int v1 = 0; v1 < this->n; v1++)
+        for(int v2 = 0; v2 < this->n; v2++)
+            if(m[v1][v2] == 1)
+                this->nb[v1].set(v2);
+
+    // greedy max-degree cover as the first incumbent
+    Bitset alive(this->n);
+    for(int v = 0; v < this->n; v++)
+        alive.set(v);
+
+    for(;;) {
+        int v = -1, dmax = 0;
+        alive.for_each([&](int u) {
+            int d = this->degree(u, alive);
+            if(d > dmax) {
+                v = u;
+                dmax = d;
+            }
+        });
+
+        if(v == -1)
+            break;
+
+        this->best.push_back(v);
+        alive.reset(v);
+    }
+}
+
+void BranchAndBound::set_incumbent(const std::vector<int>& cover) {
+
+    if(cover.size() < this->best.size())
+        this->best = cover;
+}
+
+void BranchAndBound::take(int v, Bitset& alive) {
+
+    this->chosen.push_back(v);
+    alive.reset(v);
+}
+
+bool BranchAndBound::reduce(Bitset& alive) {
+
+    bool changed = true;
+    while(changed) {
+
+        changed = false;
+
+        Bitset snapshot = alive;
+        snapshot.for_each([&](int v) {
+
+            if(!alive.test(v))
+                return;
+
+            int d = this->degree(v, alive);
+            if(d == 0) {
+                alive.reset(v);
+            } else if(d == 1) {
+                this->take(this->nb[v].first_and(alive), alive);
+                changed = true;
+            } else if(d == 2) {
+                // a triangle through v: its two other vertices are in some minimum cover
+                Bitset rest = alive;
+                rest &= this->nb[v];
+                int u = rest.first_and(alive);
+                rest.reset(u);
+                int w = rest.first_and(alive);
+
+                if(this->nb[u].test(w)) {
+                    this->take(u, alive);
+                    this->take(w, alive);
+                    changed = true;
+                }
+            } else if((int)this->chosen.size() + d >= (int)this->best.size()) {
+                // leaving v out costs all of its neighbors, which cannot beat the incumbent
+                this->take(v, alive);
+                changed = true;
+            }
+        });
+
+        if((int)this->chosen.size() >= (int)this->best.size())
+            return false;
+    }
+
+    return true;
+}
+
+int BranchAndBound::lower_bound(const Bitset& alive) const {
+
+    // every edge of a matching needs its own cover vertex
+    int matching = 0;
+    Bitset unmatched = alive;
+    alive.for_each([&](int v) {
+        if(!unmatched.test(v))
+            return;
+
+        int u = this->nb[v].first_and(unmatched);
+        if(u != -1) {
+            unmatched.reset(u);
+            unmatched.reset(v);
+            matching++;
+        }
+    });
+
+    // a clique of size s needs s - 1 cover vertices
+    std::vector<Bitset> common;
+    alive.for_each([&](int v) {
+        for(auto& c: common) {
+            if(c.test(v)) {
+                c &= this->nb[v];
+                return;
+            }
+        }
+        common.push_back(this->nb[v]);
+    });
+    int cliques = alive.count() - common.size();
+
+    return std::max(matching, cliques);
+}
+
+void BranchAndBound::search(Bitset alive) {
+
+    pthread_testcancel();
+
+    this->nodes++;
+    size_t mark = this->chosen.size();
+
+    if(this->reduce(alive)) {
+
+        int v = -1, dmax = 0;
+        alive.for_each([&](int u) {
+            int d = this->degree(u, alive);
+            if(d > dmax) {
+                v = u;
+                dmax = d;
+            }
+        });
+
+        if(v == -1) {
+            if(this->chosen.size() < this->best.size()) {
+                this->best = this->chosen;
+                if(this->improved)
+                    this->improved(this->best, this->root_lower);
+            }
+        } else if((int)this->chosen.size() + this->lower_bound(alive) < (int)this->best.size()) {
+
+            size_t branch = this->chosen.size();
+
+            Bitset with = alive;
+            this->take(v, with);
+            this->search(with);
+            this->chosen.resize(branch);
+
+            Bitset without = alive;
+            without.reset(v);
+            Bitset neighbors = this->nb[v];
+            neighbors &= alive;
+            neighbors.for_each([&](int u) {
+                this->take(u, without);
+            });
+            this->search(without);
+        }
+    }
+
+    this->chosen.resize(mark);
+}
+
+std::vector<int> BranchAndBound::solve(const std::function<void(const std::vector<int>&, int)>& improved) {
+
+    Bitset alive(this->n);
+    for(int v = 0; v < this->n; v++)
+        alive.set(v);
+
+    this->improved = improved;
+    this->root_lower = this->lower_bound(alive);
+    if(this->improved)
+        this->improved(this->best, this->root_lower);
+
+    this->chosen.clear();
+    this->search(alive);
+
+    return this->best;
+}
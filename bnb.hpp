@@ -0,0 +1,54 @@
+
+#ifndef _BNB_HPP
+#define _BNB_HPP
+
+#include <functional>
+#include <vector>
+
+#include "bitset.hpp"
+#include "graph.hpp"
+
+// Exact minimum vertex cover by branch and bound over bitset adjacency.
+// Every node applies the degree-0/1/2 and high-degree reductions, prunes on
+// the larger of a matching and a clique cover lower bound, and branches on a
+// maximum degree vertex (take it, or take all of its neighbors).
+class BranchAndBound {
+
+    private:
+
+        int n;
+        std::vector<Bitset> nb;
+
+        std::vector<int> chosen;
+        std::vector<int> best;
+
+        long nodes;
+
+        int root_lower;
+        std::function<void(const std::vector<int>&, int)> improved;
+
+        int degree(int v, const Bitset& alive) const {
+            return this->nb[v].count_and(alive);
+        }
+
+        void take(int v, Bitset& alive);
+        bool reduce(Bitset& alive);
+        int lower_bound(const Bitset& alive) const;
+        void search(Bitset alive);
+
+    public:
+
+        BranchAndBound(const Graph& g);
+
+        // an upper bound to start pruning from; must be a valid cover
+        void set_incumbent(const std::vector<int>& cover);
+
+        // improved, if set, is called with every better cover found
+        std::vector<int> solve(const std::function<void(const std::vector<int>&, int)>& improved = nullptr);
+
+        long explored() const {
+            return this->nodes;
+        }
+};
+
+#endif
@@ -0,0 +1,256 @@
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cardinality.hpp"
+
+using Minisat::Lit;
+using Minisat::lit_Undef;
+
+void CardinalityEncoder::at_most(CnfSink& sink, const std::vector<Lit>& lits, int k) {
+
+    if(k >= (int)lits.size())
+        return;
+
+    if(k < 0) {
+        sink.add({});
+        return;
+    }
+
+    if(k == 0) {
+        for(Lit l: lits)
+            sink.add({~l});
+        return;
+    }
+
+    this->at_most_k(sink, lits, k);
+}
+
+void SequentialCounter::at_most_k(CnfSink& sink, const std::vector<Lit>& lits, int k) {
+
+    // s[i][j]: at least j + 1 of lits[0..i] are true
+    size_t n = lits.size();
+    std::vector<std::vector<Lit>> s(n - 1, std::vector<Lit>(k));
+    for(size_t i = 0; i + 1 < n; i++)
+        for(int j = 0; j < k; j++)
+            s[i][j] = sink.fresh();
+
+    sink.add({~lits[0], s[0][0]});
+    for(int j = 1; j < k; j++)
+        sink.add({~s[0][j]});
+
+    for(size_t i = 1; i + 1 < n; i++) {
+        sink.add({~lits[i], s[i][0]});
+        sink.add({~s[i-1][0], s[i][0]});
+        for(int j = 1; j < k; j++) {
+            sink.add({~lits[i], ~s[i-1][j-1], s[i][j]});
+            sink.add({~s[i-1][j], s[i][j]});
+        }
+        sink.add({~lits[i], ~s[i-1][k-1]});
+    }
+
+    sink.add({~lits[n-1], ~s[n-2][k-1]});
+}
+
+std::vector<Lit> Totalizer::count(CnfSink& sink, const std::vector<Lit>& lits, size_t lo, size_t hi, int k) {
+
+    // out[j]: at least j + 1 of lits[lo..hi) are true, for j <= k
+    if(hi - lo == 1)
+        return std::vector<Lit>{lits[lo]};
+
+    size_t mid = (lo + hi) / 2;
+    std::vector<Lit> a = this->count(sink, lits, lo, mid, k);
+    std::vector<Lit> b = this->count(sink, lits, mid, hi, k);
+
+    std::vector<Lit> out(std::min(a.size() + b.size(), (size_t)k + 1));
+    for(size_t j = 0; j < out.size(); j++)
+        out[j] = sink.fresh();
+
+    // i of a and j of b -> i + j of out
+    for(size_t i = 0; i <= a.size(); i++) {
+        for(size_t j = 0; j <= b.size(); j++) {
+            if(i + j == 0 || i + j > out.size())
+                continue;
+
+            Lit clause[3];
+            size_t size = 0;
+            if(i > 0)
+                clause[size++] = ~a[i-1];
+            if(j > 0)
+                clause[size++] = ~b[j-1];
+            clause[size++] = out[i+j-1];
+            sink.add(clause, size);
+        }
+    }
+
+    return out;
+}
+
+void Totalizer::at_most_k(CnfSink& sink, const std::vector<Lit>& lits, int k) {
+
+    std::vector<Lit> out = this->count(sink, lits, 0, lits.size(), k);
+    sink.add({~out[k]});
+}
+
+void SortingNetwork::at_most_k(CnfSink& sink, const std::vector<Lit>& lits, int k) {
+
+    // padded to a power of two with constant false inputs (lit_Undef), which
+    // a comparator passes through without new variables
+    size_t n = 1;
+    while(n < lits.size())
+        n *= 2;
+    std::vector<Lit> wire(lits);
+    wire.resize(n, lit_Undef);
+
+    // the larger value moves to the lower index: wire ends up descending
+    auto compare = [&](size_t i, size_t j) {
+        Lit a = wire[i], b = wire[j];
+        if(b == lit_Undef)
+            return;
+        if(a == lit_Undef) {
+            wire[i] = b;
+            wire[j] = lit_Undef;
+            return;
+        }
+
+        Lit hi = sink.fresh(), lo = sink.fresh();
+        sink.add({~a, hi});
+        sink.add({~b, hi});
+        sink.add({~a, ~b, lo});
+        wire[i] = hi;
+        wire[j] = lo;
+    };
+
+    for(size_t p = 1; p < n; p *= 2)
+        for(size_t q = p; q >= 1; q /= 2)
+            for(size_t j = q % p; j + q < n; j += 2 * q)
+                for(size_t i = 0; i < std::min(q, n - j - q); i++)
+                    if((i + j) / (2 * p) == (i + j + q) / (2 * p))
+                        compare(i + j, i + j + q);
+
+    sink.add({~wire[k]});
+}
+
+std::vector<Lit> Adder::add(CnfSink& sink, const std::vector<Lit>& a, const std::vector<Lit>& b) {
+
+    // binary numbers, least significant bit first
+    std::vector<Lit> sum;
+    Lit carry = lit_Undef;
+    for(size_t i = 0; i < std::max(a.size(), b.size()); i++) {
+
+        Lit in[3];
+        size_t size = 0;
+        if(i < a.size())
+            in[size++] = a[i];
+        if(i < b.size())
+            in[size++] = b[i];
+        if(carry != lit_Undef)
+            in[size++] = carry;
+
+        if(size == 1) {
+            sum.push_back(in[0]);
+            carry = lit_Undef;
+            continue;
+        }
+
+        // s <-> xor of in, c <-> at least two of in
+        Lit s = sink.fresh(), c = sink.fresh();
+        for(int mask = 0; mask < (1 << size); mask++) {
+            Lit clause[4];
+            for(size_t j = 0; j < size; j++)
+                clause[j] = (mask >> j) & 1 ? ~in[j] : in[j];
+            clause[size] = __builtin_popcount(mask) % 2 == 1 ? s : ~s;
+            sink.add(clause, size + 1);
+        }
+
+        if(size == 2) {
+            sink.add({~in[0], ~in[1], c});
+            sink.add({in[0], ~c});
+            sink.add({in[1], ~c});
+        } else {
+            for(size_t x = 0; x < 3; x++) {
+                for(size_t y = x + 1; y < 3; y++) {
+                    sink.add({~in[x], ~in[y], c});
+                    sink.add({in[x], in[y], ~c});
+                }
+            }
+        }
+
+        sum.push_back(s);
+        carry = c;
+    }
+
+    if(carry != lit_Undef)
+        sum.push_back(carry);
+    return sum;
+}
+
+void Adder::at_most_k(CnfSink& sink, const std::vector<Lit>& lits, int k) {
+
+    // pairwise rounds keep the operands of every adder about the same width
+    std::vector<std::vector<Lit>> numbers;
+    for(Lit l: lits)
+        numbers.push_back(std::vector<Lit>{l});
+
+    while(numbers.size() > 1) {
+        std::vector<std::vector<Lit>> next;
+        for(size_t i = 0; i + 1 < numbers.size(); i += 2)
+            next.push_back(this->add(sink, numbers[i], numbers[i+1]));
+        if(numbers.size() % 2 == 1)
+            next.push_back(numbers.back());
+        numbers.swap(next);
+    }
+
+    // sum > k iff at some bit i the sum has 1 where k has 0 and all higher
+    // bits agree; every such i gets a clause against it
+    const std::vector<Lit>& sum = numbers[0];
+    if(sum.size() < 32 && (k >> sum.size()) != 0)
+        return;
+
+    std::vector<Lit> clause;
+    for(size_t i = 0; i < sum.size(); i++) {
+        if((k >> i) & 1)
+            continue;
+
+        clause.assign(1, ~sum[i]);
+        for(size_t j = i + 1; j < sum.size(); j++)
+            clause.push_back((k >> j) & 1 ? ~sum[j] : sum[j]);
+        sink.add(clause);
+    }
+}
+
+std::unique_ptr<CardinalityEncoder> make_cardinality_encoder(cardinality_encoding encoding) {
+
+    switch(encoding) {
+        case CARD_SEQUENTIAL:   return std::unique_ptr<CardinalityEncoder>(new SequentialCounter());
+        case CARD_TOTALIZER:    return std::unique_ptr<CardinalityEncoder>(new Totalizer());
+        case CARD_SORTER:       return std::unique_ptr<CardinalityEncoder>(new SortingNetwork());
+        case CARD_ADDER:        return std::unique_ptr<CardinalityEncoder>(new Adder());
+        default:                return std::unique_ptr<CardinalityEncoder>();
+    }
+}
+
+std::string cardinality_name(cardinality_encoding encoding) {
+
+    switch(encoding) {
+        case CARD_SLOTS:        return "slots";
+        case CARD_SEQUENTIAL:   return "seq";
+        case CARD_TOTALIZER:    return "totalizer";
+        case CARD_SORTER:       return "sorter";
+        case CARD_ADDER:        return "adder";
+    }
+    return "unknown";
+}
+
+bool parse_cardinality(const std::string& name, cardinality_encoding& encoding) {
+
+    for(cardinality_encoding e: {CARD_SLOTS, CARD_SEQUENTIAL, CARD_TOTALIZER, CARD_SORTER, CARD_ADDER}) {
+        if(cardinality_name(e) == name) {
+            encoding = e;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,103 @@
+
+#ifndef _CARDINALITY_HPP
+#define _CARDINALITY_HPP
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minisat/core/SolverTypes.h"
+
+// Where an encoding puts its clauses: a solver, a file, a counter.
+// Encoders only ask for fresh variables and hand over finished clauses,
+// which the sink copies: a clause can live in a reused buffer or in braces
+// on the stack.
+class CnfSink {
+
+    public:
+
+        virtual ~CnfSink() {}
+
+        virtual Minisat::Lit fresh() = 0;
+        virtual void add(const Minisat::Lit *clause, size_t size) = 0;
+
+        // the size of the CNF to come, for sinks that store it
+        virtual void reserve(size_t vars, size_t clauses, size_t literals) {}
+
+        void add(std::initializer_list<Minisat::Lit> clause) {
+            this->add(clause.begin(), clause.size());
+        }
+
+        void add(const std::vector<Minisat::Lit>& clause) {
+            this->add(clause.data(), clause.size());
+        }
+};
+
+// How vc_cnf_sat states "at most k vertices": k position slots per vertex,
+// or one variable per vertex under an at-most-k constraint in one of the
+// cardinality encodings below.
+enum cardinality_encoding {
+    CARD_SLOTS,
+    CARD_SEQUENTIAL,
+    CARD_TOTALIZER,
+    CARD_SORTER,
+    CARD_ADDER
+};
+
+// Clauses for "at most k of lits are true". Only the direction that can
+// make the constraint fail is encoded, so a model may leave the auxiliary
+// variables above the true count.
+class CardinalityEncoder {
+
+    protected:
+
+        // 0 < k < lits.size()
+        virtual void at_most_k(CnfSink& sink, const std::vector<Minisat::Lit>& lits, int k) = 0;
+
+    public:
+
+        virtual ~CardinalityEncoder() {}
+
+        void at_most(CnfSink& sink, const std::vector<Minisat::Lit>& lits, int k);
+};
+
+// Sinz's sequential counter: n k registers, O(n k) clauses.
+class SequentialCounter: public CardinalityEncoder {
+    protected:
+        void at_most_k(CnfSink& sink, const std::vector<Minisat::Lit>& lits, int k);
+};
+
+// Bailleux and Boufkhad's totalizer: a tree of unary adders cut at k + 1
+// outputs, O(n k) clauses with O(n log n) variables for small k.
+class Totalizer: public CardinalityEncoder {
+    private:
+        std::vector<Minisat::Lit> count(CnfSink& sink, const std::vector<Minisat::Lit>& lits, size_t lo, size_t hi, int k);
+    protected:
+        void at_most_k(CnfSink& sink, const std::vector<Minisat::Lit>& lits, int k);
+};
+
+// Batcher's odd-even merge sort of the literals, O(n log^2 n) comparators
+// independent of k; the (k + 1)-th largest output must be false.
+class SortingNetwork: public CardinalityEncoder {
+    protected:
+        void at_most_k(CnfSink& sink, const std::vector<Minisat::Lit>& lits, int k);
+};
+
+// Warners' adder: the count in binary through a tree of ripple-carry
+// adders, O(n) clauses, compared bitwise against k.
+class Adder: public CardinalityEncoder {
+    private:
+        std::vector<Minisat::Lit> add(CnfSink& sink, const std::vector<Minisat::Lit>& a, const std::vector<Minisat::Lit>& b);
+    protected:
+        void at_most_k(CnfSink& sink, const std::vector<Minisat::Lit>& lits, int k);
+};
+
+std::unique_ptr<CardinalityEncoder> make_cardinality_encoder(cardinality_encoding encoding);
+
+std::string cardinality_name(cardinality_encoding encoding);
+
+// "slots", "seq", "totalizer", "sorter" or "adder"; false if unknown
+bool parse_cardinality(const std::string& name, cardinality_encoding& encoding);
+
+#endif
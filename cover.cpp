@@ -1,14 +1,34 @@
 
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <queue>
 #include <vector>
 #include <map>
+#include <string>
 
 #include "cover.hpp"
+#include "bnb.hpp"
+#include "cube.hpp"
+#include "dimacs.hpp"
+#include "satbackend.hpp"
+#include "fpt.hpp"
+#include "kernel.hpp"
+#include "localsearch.hpp"
+#include "matching.hpp"
+#include "pool.hpp"
+#include "portfolio.hpp"
+#include "treedp.hpp"
+#include "masksolver.hpp"
+#include "stats.hpp"
 #include "minisat/core/SolverTypes.h"
-#include "minisat/core/Solver.h"
 
-VCSolver::VCSolver() {
+VCSolver::VCSolver(const cnf_options& cnf): cnf(cnf) {
  
 }
 
@@ -23,6 +43,8 @@ std::pair<bool, std::vector<int>> VCSolver::vc_approx_1(Graph g) {
     // vector of (vertex, degree) pairs ranked descendingly by degree
     std::vector<std::pair<int, int>> edges = g.get_edges();
     while(!edges.empty()) {   
+
+        pthread_testcancel();
         
         std::vector<std::pair<int, int>> ranked_vertices = g.get_ranked_vertices();
         std::pair<int, int> v = ranked_vertices[0];
@@ -53,6 +75,7 @@ std::pair<bool, std::vector<int>> VCSolver::vc_approx_2(Graph g) {
 
    for(auto it = edges.begin(); it != edges.end(); ++it) {
        
+       pthread_testcancel();
        auto edge = it->first;
        if(edges[edge] == false) {
 
@@ -77,32 +100,411 @@ std::pair<bool, std::vector<int>> VCSolver::vc_approx_2(Graph g) {
    return std::make_pair(true, cover);
 }
 
-std::pair<bool, std::vector<int>> VCSolver::vc_cnf_sat(Graph g, int k) {
-    
+std::pair<bool, std::vector<int>> VCSolver::vc_prune(Graph g, const std::vector<int>& cover) {
+
+    // A cover vertex is redundant when none of its neighbors is left out of
+    // the cover. outside[v] counts those neighbors; dropping v adds one to
+    // each neighbor's count, which keeps the whole pass linear.
+    std::vector<std::vector<int>> adj(g.vs());
+    for(auto const& e: g.get_edges()) {
+        adj[e.first].push_back(e.second);
+        adj[e.second].push_back(e.first);
+    }
+
+    std::vector<bool> in(g.vs(), false);
+    for(int v: cover)
+        in[v] = true;
+
+    std::vector<int> outside(g.vs(), 0);
+    for(int v = 0; v < g.vs(); v++)
+        for(int u: adj[v])
+            if(!in[u])
+                outside[v]++;
+
+    // low degree first: dropping a vertex pins all of its neighbors
+    std::vector<std::vector<int>> by_degree(g.vs());
+    for(int v: cover)
+        by_degree[adj[v].size()].push_back(v);
+
+    for(auto const& bucket: by_degree) {
+        for(int v: bucket) {
+            if(!in[v] || outside[v] != 0)
+                continue;
+
+            in[v] = false;
+            for(int u: adj[v])
+                outside[u]++;
+        }
+    }
+
+    std::vector<int> pruned;
+    for(int v = 0; v < g.vs(); v++)
+        if(in[v])
+            pruned.push_back(v);
+
+    return std::make_pair(true, pruned);
+}
+
+std::pair<bool, std::vector<int>> VCSolver::vc_bnb(Graph g, const vc_progress& progress) {
+
+    BranchAndBound bnb(g);
+    std::vector<int> cover = bnb.solve(progress);
+
+    stats_add("bnb.nodes", bnb.explored());
+    return std::make_pair(true, cover);
+}
+
+std::pair<bool, std::vector<int>> VCSolver::vc_small(Graph g) {
+
+    // one or two words of neighbor mask per vertex; larger graphs are refused
+    if(g.vs() <= 64)
+        return std::make_pair(true, MaskSolver<1>(g).solve());
+    if(g.vs() <= 128)
+        return std::make_pair(true, MaskSolver<2>(g).solve());
+
+    return std::make_pair(false, std::vector<int>{});
+}
+
+std::pair<bool, std::vector<int>> VCSolver::vc_bipartite(Graph g) {
+
+    if(!g.is_bipartite())
+        return std::make_pair(false, std::vector<int>{});
+
+    // König: in a bipartite graph a maximum matching and a minimum cover
+    // have the same size, and the cover falls out of the matching
+    std::vector<int> id(g.vs());
+    std::vector<int> left, right;
+    for(int v = 0; v < g.vs(); v++) {
+        if(g.side_of(v) == 0) {
+            id[v] = left.size();
+            left.push_back(v);
+        } else {
+            id[v] = right.size();
+            right.push_back(v);
+        }
+    }
+
+    std::vector<std::vector<int>> adj(left.size());
+    for(auto const& e: g.get_edges()) {
+        int u = g.side_of(e.first) == 0 ? e.first : e.second;
+        int v = g.side_of(e.first) == 0 ? e.second : e.first;
+        adj[id[u]].push_back(id[v]);
+    }
+
+    BipartiteMatching matching(left.size(), right.size(), adj);
+    std::vector<bool> in_left, in_right;
+    matching.min_vertex_cover(in_left, in_right);
+
+    std::vector<int> cover;
+    for(size_t i = 0; i < left.size(); i++)
+        if(in_left[i])
+            cover.push_back(left[i]);
+    for(size_t i = 0; i < right.size(); i++)
+        if(in_right[i])
+            cover.push_back(right[i]);
+
+    return std::make_pair(true, cover);
+}
+
+std::pair<bool, std::vector<int>> VCSolver::vc_forest(Graph g) {
+
+    // acyclic exactly when there is one edge less than vertices per component
+    std::vector<std::vector<int>> components = g.get_components();
+    if(g.get_edges().size() != (size_t)g.vs() - components.size())
+        return std::make_pair(false, std::vector<int>{});
+
+    int **m = g.adjmat();
+    std::vector<int> parent(g.vs(), -1);
+    std::vector<int> order;
+    for(auto const& c: components) {
+
+        std::queue<int> q;
+        parent[c[0]] = c[0];
+        q.push(c[0]);
+
+        while(q.size() > 0) {
+            int u = q.front();
+            q.pop();
+            order.push_back(u);
+
+            for(int v = 0; v < g.vs(); v++) {
+                if(m[u][v] == 1 && parent[v] == -1) {
+                    parent[v] = u;
+                    q.push(v);
+                }
+            }
+        }
+    }
+
+    // leaves up: an edge to the parent still uncovered is covered by the parent
+    std::vector<bool> in(g.vs(), false);
+    for(auto it = order.rbegin(); it != order.rend(); ++it) {
+        int v = *it;
+        if(parent[v] != v && !in[v] && !in[parent[v]])
+            in[parent[v]] = true;
+    }
+
+    std::vector<int> cover;
+    for(int v = 0; v < g.vs(); v++)
+        if(in[v])
+            cover.push_back(v);
+
+    return std::make_pair(true, cover);
+}
+
+std::pair<bool, std::vector<int>> VCSolver::vc_treewidth(Graph g, int max_width) {
+
+    TreewidthSolver dp(g, max_width);
+    if(dp.width() == -1)
+        return std::make_pair(false, std::vector<int>{});
+
+    stats_max("treedp.width", dp.width());
+    return std::make_pair(true, dp.solve());
+}
+
+std::pair<bool, std::vector<int>> VCSolver::vc_local_search(Graph g, double seconds, const vc_progress& progress) {
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += (time_t)seconds;
+    deadline.tv_nsec += (long)((seconds - (time_t)seconds) * 1E9);
+    if(deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    // small graphs settle long before the deadline; stop them once the
+    // search has stalled for a while instead
+    LocalSearch search(g);
+    long stall = std::max(10000L, 50L * (g.vs() + (long)g.get_edges().size()));
+    std::vector<int> cover = search.solve(deadline, stall, progress);
+
+    stats_add("ls.steps", search.steps());
+    return std::make_pair(true, cover);
+}
+
+std::pair<bool, std::vector<int>> VCSolver::vc_decide(Graph g, int k) {
+
+    // With k as the budget every reduction keeps the answer the same, and
+    // after Buss' rule no vertex has more than k' neighbors left.
+    Kernel kernel(g, k);
+    int budget = k - kernel.offset();
+    if(budget < 0 || kernel.lower_bound() > k)
+        return std::make_pair(false, std::vector<int>{});
+
+    Graph& reduced = kernel.graph();
+    if(reduced.get_edges().size() > (size_t)budget * budget)
+        return std::make_pair(false, std::vector<int>{});
+
+    BoundedSearch search(reduced);
+    std::pair<bool, std::vector<int>> result = search.solve(budget);
+    if(!result.first)
+        return result;
+
+    return std::make_pair(true, kernel.lift(result.second));
+}
+
+// Clauses for: "the cover is no larger in lex order than its image under
+// each automorphism", over y[v] ("v is in the cover") ordered by vertex.
+// The smallest cover of every orbit satisfies all of them.
+// e is "y agrees with its image on every vertex so far":
+// e -> (~y[v] v y[s(v)]),  e & y[v] == y[s(v)] -> e'
+static void add_lex_leader(CnfSink& sink, const std::vector<Minisat::Lit>& y, const std::vector<std::vector<int>>& automorphisms) {
+
+    for(auto const& sigma: automorphisms) {
+
+        Minisat::Lit e = Minisat::lit_Undef;
+        for(size_t v = 0; v < y.size(); v++) {
+            size_t s = sigma[v];
+            if(s == v)
+                continue;
+
+            // e is true before the first vertex that moves
+            Minisat::Lit next = sink.fresh();
+            if(e == Minisat::lit_Undef) {
+                sink.add({~y[v], y[s]});
+                sink.add({~y[v], ~y[s], next});
+                sink.add({y[v], y[s], next});
+            } else {
+                sink.add({~e, ~y[v], y[s]});
+                sink.add({~e, ~y[v], ~y[s], next});
+                sink.add({~e, y[v], y[s], next});
+            }
+
+            e = next;
+        }
+    }
+}
+
+// Warm start from a known cover. In the k-slot encoding its k highest
+// degree vertices take the k positions in the first assignment tried; with
+// one variable per vertex its vertices are tried in the cover. Either way
+// the decisions start with them and then go by degree. The search itself is
+// unchanged.
+static void warm_start(SatBackend& solver, Graph& g, int k, const std::vector<int>& hint, const std::vector<Minisat::Lit>& vars, bool slots) {
+
     size_t N = (size_t)g.vs();
-    Minisat::Lit **lit = new Minisat::Lit* [N+1];
-    for(size_t i = 1; i <= N; i++)
-        lit[i] = new Minisat::Lit[k+1];
+    int **m = g.adjmat();
+    std::vector<int> degree(N, 0);
+    int max_degree = 1;
+    for(size_t i = 0; i < N; i++) {
+        for(size_t j = 0; j < N; j++)
+            degree[i] += m[i][j] == 1;
+        max_degree = std::max(max_degree, degree[i]);
+    }
+
+    std::vector<int> ranked = hint;
+    if(slots) {
+        std::stable_sort(ranked.begin(), ranked.end(), [&](int a, int b) {
+            return degree[a] > degree[b];
+        });
+
+        // in increasing order, as position symmetry breaking wants them
+        ranked.resize(std::min(ranked.size(), (size_t)k));
+        std::sort(ranked.begin(), ranked.end());
+    }
+
+    std::vector<int> position(N, 0);
+    for(size_t p = 0; p < ranked.size(); p++)
+        position[ranked[p]] = p + 1;
+
+    size_t width = vars.size() / std::max(N, (size_t)1);
+    for(size_t i = 0; i < N; i++) {
+        double activity = degree[i] / (double)max_degree + (position[i] != 0 ? 1 : 0);
+        for(size_t j = 0; j < width; j++)
+            solver.warm(Minisat::var(vars[i * width + j]) + 1, slots ? position[i] == (int)j + 1 : position[i] != 0, activity);
+    }
+}
+
+// The vertices cube-and-conquer branches on, at most depth of them: each
+// has the highest degree once the earlier ones are in the cover, that is,
+// counting only the edges they leave uncovered.
+static std::vector<int> split_vertices(Graph& g, int depth) {
+
+    size_t N = (size_t)g.vs();
+    int **m = g.adjmat();
+    std::vector<int> degree(N, 0);
+    for(size_t i = 0; i < N; i++)
+        for(size_t j = 0; j < N; j++)
+            degree[i] += m[i][j] == 1;
+
+    std::vector<int> split;
+    std::vector<bool> taken(N, false);
+    while(split.size() < (size_t)depth) {
+        int best = -1;
+        for(size_t v = 0; v < N; v++)
+            if(!taken[v] && (best < 0 || degree[v] > degree[best]))
+                best = v;
+
+        // every edge is covered: branching further splits nothing
+        if(best < 0 || degree[best] == 0)
+            break;
+
+        taken[best] = true;
+        split.push_back(best);
+        for(size_t u = 0; u < N; u++)
+            degree[u] -= m[best][u] == 1 && !taken[u];
+    }
+
+    return split;
+}
+
+// One cube per way of putting the split vertices in or out of the cover, as
+// assumptions on their variables. A vertex out of the cover puts its
+// neighbours in, which refutes the cubes with two adjacent vertices out or
+// more than k vertices in; those are counted in pruned instead.
+static std::vector<std::vector<int>> make_cubes(Graph& g, int k, const std::vector<int>& split, const std::vector<Minisat::Lit>& vertex, size_t& pruned) {
+
+    size_t N = (size_t)g.vs();
+    int **m = g.adjmat();
+    std::vector<std::vector<int>> cubes;
+    pruned = 0;
+
+    for(size_t mask = 0; mask < ((size_t)1 << split.size()); mask++) {
+        std::vector<bool> in(N, false);
+        for(size_t i = 0; i < split.size(); i++) {
+            if(mask >> i & 1) {
+                in[split[i]] = true;
+            } else {
+                for(size_t u = 0; u < N; u++)
+                    in[u] = in[u] || m[split[i]][u] == 1;
+            }
+        }
+
+        bool refuted = std::count(in.begin(), in.end(), true) > k;
+        for(size_t i = 0; i < split.size(); i++)
+            refuted = refuted || (!(mask >> i & 1) && in[split[i]]);
+        if(refuted) {
+            pruned++;
+            continue;
+        }
+
+        std::vector<int> cube;
+        for(size_t i = 0; i < split.size(); i++) {
+            int v = Minisat::var(vertex[split[i]]) + 1;
+            cube.push_back(mask >> i & 1 ? v : -v);
+        }
+        cubes.push_back(cube);
+    }
+
+    return cubes;
+}
+
+std::vector<Minisat::Lit> VCSolver::encode_slots(Graph& g, int k, CnfSink& sink, std::vector<Minisat::Lit>& vertex) {
+
+    size_t N = (size_t)g.vs();
+    size_t K = (size_t)k;
+    size_t E = g.get_edges().size();
+    bool per_vertex = !this->cnf.automorphisms.empty() || this->cnf.backend == SAT_MINISAT_SIMP || this->cnf.cube_depth > 0;
+
+    // x[i][j] for i in [1, n] and j in [1, k], row by row in one array
+    std::vector<Minisat::Lit> lit(N * K);
+    auto x = [&](size_t i, size_t j) -> Minisat::Lit& {
+        return lit[(i - 1) * K + (j - 1)];
+    };
+
+    // the clauses below, counted ahead so that a sink storing them grows once
+    size_t clauses = K + N * K * (K - 1) / 2 + K * N * (N - 1) / 2 + E;
+    size_t literals = K * N + N * K * (K - 1) + K * N * (N - 1) + E * 2 * K;
+    if(this->cnf.break_positions && K > 1) {
+        clauses += (K - 1) * N * (N + 1) / 2;
+        literals += (K - 1) * N * (N + 1);
+    }
+    if(per_vertex) {
+        clauses += N * (K + 1);
+        literals += N * (3 * K + 1);
+    }
+
+    // the lex-leader clauses: a variable and three clauses of at most eleven
+    // literals in all for every vertex an automorphism moves
+    size_t moved = 0;
+    for(auto const& sigma: this->cnf.automorphisms)
+        for(size_t v = 0; v < N; v++)
+            moved += (size_t)sigma[v] != v;
+    clauses += 3 * moved;
+    literals += 11 * moved;
+
+    sink.reserve(N * K + (per_vertex ? N : 0) + moved, clauses, literals);
 
-    std::unique_ptr<Minisat::Solver> solver(new Minisat::Solver());
-    int nclauses = 0;
-    
     for(size_t i = 1; i <= N; i++) {
 	    for(size_t j = 1; j <= (size_t)k; j++) {
-	        lit[i][j] = Minisat::mkLit(solver->newVar());
+	        x(i, j) = sink.fresh();
 	    }
     }
 
     // Clauses for: "at least one vertex is the i-th vertex in the vertex cover"
     // i in [1, k] -> (x[1][i] v x[2][i] v ... v x[n][i] 
 
+    // one buffer for the long clauses, reused
+    std::vector<Minisat::Lit> clause;
+    clause.reserve(std::max(N, 2 * K) + 1);
+
     for(size_t i = 1; i <= (size_t)k; i++) {
-        Minisat::vec<Minisat::Lit> clause;
+        clause.clear();
         for(size_t m = 1; m <= N; m++)
-            clause.push(lit[m][i]);
+            clause.push_back(x(m, i));
 
-        solver->addClause(clause);
-        nclauses += 1;
+        sink.add(clause);
     }
 	
     // Clauses for: "no one vertex can appear twice in a vertex cover"
@@ -112,8 +514,7 @@ std::pair<bool, std::vector<int>> VCSolver::vc_cnf_sat(Graph g, int k) {
         for(size_t p = 1; p <= (size_t)k; p++) {
             for(size_t q = 1; q <= (size_t)k; q++) {
                 if(p < q) {
-                    solver->addClause(~lit[m][p], ~lit[m][q]);
-                    nclauses += 1;
+                    sink.add({~x(m, p), ~x(m, q)});
                 }
             }
         }
@@ -122,17 +523,56 @@ std::pair<bool, std::vector<int>> VCSolver::vc_cnf_sat(Graph g, int k) {
     // Clauses for: "no one vertex appears in the m-th position of thvertex cover"
     // m in [1, k], p, q in [1, N], p < q -> ~x[p][m] v ~x[q][m]
     //
+    // the bulk of the CNF: a cancelled thread stops here
     for(size_t m = 1; m <= (size_t)k; m++) {
         for(size_t p = 1; p <= N; p++) {
+            pthread_testcancel();
             for(size_t q = 1; q <= N; q++) {
                 if(p < q) {
-                    solver->addClause(~lit[p][m], ~lit[q][m]); 
-                    nclauses += 1;
+                    sink.add({~x(p, m), ~x(q, m)}); 
+                }
+            }
+        }
+    }
+
+    // Clauses for: "the vertex after vertex i in the cover has a higher index"
+    // p in [1, k-1], j <= i -> ~x[i][p] v ~x[j][p+1]
+    // Without them each cover of size k has k! models, all of which an
+    // unsatisfiable k has to refute.
+    //
+    if(this->cnf.break_positions) {
+        for(size_t p = 1; p < (size_t)k; p++) {
+            for(size_t i = 1; i <= N; i++) {
+                for(size_t j = 1; j <= i; j++) {
+                    sink.add({~x(i, p), ~x(j, p+1)});
                 }
             }
         }
     }
 
+    // Per-vertex variables y[i] <-> x[i][1] v ... v x[i][k], for the
+    // lex-leader clauses, as the variables preprocessing must keep and as
+    // the ones cubes assume
+    //
+    vertex.clear();
+    if(per_vertex) {
+        std::vector<Minisat::Lit> y(N);
+        for(size_t i = 1; i <= N; i++) {
+            y[i-1] = sink.fresh();
+
+            clause.assign(1, ~y[i-1]);
+            for(size_t j = 1; j <= (size_t)k; j++) {
+                clause.push_back(x(i, j));
+                sink.add({y[i-1], ~x(i, j)});
+            }
+            sink.add(clause);
+        }
+
+        if(!this->cnf.automorphisms.empty())
+            add_lex_leader(sink, y, this->cnf.automorphisms);
+        vertex = y;
+    }
+
     // Clauses for: "every edge is incident to at least one vertex in the vertex cover"
     // <i, j> in edges(g) -> x[i][1] v x[i][2] v ... v x[i][k] v x[j][1] v x[j][2] v ... x[j][k]
     //
@@ -142,37 +582,252 @@ std::pair<bool, std::vector<int>> VCSolver::vc_cnf_sat(Graph g, int k) {
             
             if(i < j && edges[i-1][j-1] == 1) {
                 
-                Minisat::vec<Minisat::Lit> clause;
+                clause.clear();
                 for(size_t m = 1; m <= (size_t)k; m++) {
-                    clause.push(lit[i][m]);
-                    clause.push(lit[j][m]);
+                    clause.push_back(x(i, m));
+                    clause.push_back(x(j, m));
                 }
 
-                solver->addClause(clause);
-                nclauses += 1;
+                sink.add(clause);
             }
         }
     }
-    
-    // Collect model
+
+    return lit;
+}
+
+std::vector<Minisat::Lit> VCSolver::encode_direct(Graph& g, int k, CnfSink& sink, std::vector<Minisat::Lit>& vertex) {
+
+    size_t N = (size_t)g.vs();
+    size_t E = g.get_edges().size();
+    int **m = g.adjmat();
+
+    // only the edge clauses are counted here; the cardinality encoder's
+    // clauses come on top of them, unannounced
+    sink.reserve(N, E, 2 * E);
+
+    // x[v]: v is in the cover
+    std::vector<Minisat::Lit> x(N);
+    for(size_t v = 0; v < N; v++)
+        x[v] = sink.fresh();
+
+    // Clauses for: "every edge is incident to at least one vertex in the vertex cover"
+    // <i, j> in edges(g) -> x[i] v x[j]
+    //
+    for(size_t i = 0; i < N; i++)
+        for(size_t j = i + 1; j < N; j++)
+            if(m[i][j] == 1)
+                sink.add({x[i], x[j]});
+
+    // Clauses for: "at most k of x[1..n] are true"
     //
-    bool res = solver->solve();
+    make_cardinality_encoder(this->cnf.cardinality)->at_most(sink, x, k);
+
+    if(!this->cnf.automorphisms.empty())
+        add_lex_leader(sink, x, this->cnf.automorphisms);
+
+    vertex = x;
+    return x;
+}
+
+// the vertices of N a model puts in the cover: those with any of their
+// width literals in vars true
+static std::vector<int> read_cover(const std::vector<bool>& value, const std::vector<Minisat::Lit>& vars, size_t N, size_t width) {
+
     std::vector<int> cover;
-    if(res) {
-        for(size_t i = 1; i <= N; i++) {
-            for(int j = 1; j <= k; j++) {
-                if (Minisat::toInt(solver->modelValue(lit[i][j])) == 0) {
-                    cover.push_back(i-1);
-                }
+    for(size_t i = 0; i < N; i++) {
+        for(size_t j = i * width; j < (i + 1) * width; j++) {
+            if(value[Minisat::var(vars[j])]) {
+                cover.push_back(i);
+                break;
             }
         }
     }
 
-    solver.reset(new Minisat::Solver());
+    return cover;
+}
+
+// whether cover has at most k vertices and touches every edge of g
+static bool check_cover(Graph& g, int k, const std::vector<int>& cover) {
+
+    if((int)cover.size() > k)
+        return false;
+
+    std::vector<bool> in(g.vs(), false);
+    for(int v: cover)
+        in[v] = true;
+    for(auto const& e: g.get_edges())
+        if(!in[e.first] && !in[e.second])
+            return false;
 
-    for(size_t i = 1; i <= N; i++)
-        delete[] lit[i];
-    delete[] lit;
+    return true;
+}
+
+std::pair<bool, std::vector<int>> VCSolver::vc_cnf_sat(Graph g, int k, const std::vector<int>& hint) {
     
+    size_t N = (size_t)g.vs();
+    bool slots = this->cnf.cardinality == CARD_SLOTS;
+
+    // one backend, the members of a portfolio or one cube-and-conquer
+    // worker per CPU, all given the same CNF; members past the CPUs would
+    // only start once the race is over
+    size_t cpus = (size_t)std::max(sysconf(_SC_NPROCESSORS_ONLN), 1L);
+    size_t nmembers = std::min((size_t)std::max(this->cnf.portfolio, 1), cpus);
+    int depth = std::min(this->cnf.cube_depth, MAX_CUBE_DEPTH);
+    if(depth > 0)
+        nmembers = std::min(cpus, (size_t)1 << depth);
+
+    std::vector<std::unique_ptr<SatBackend>> solvers;
+    std::vector<SatBackend*> members;
+    for(size_t i = 0; i < nmembers; i++) {
+        solvers.push_back(make_sat_backend(this->cnf.backend));
+        solvers.back()->diversify(i);
+        members.push_back(solvers.back().get());
+    }
+    SatBackend *solver = members[0];
+
+    // A single backend takes the clauses as they are made; several are
+    // loaded side by side from one recording afterwards. A CNF that leaves
+    // the process is recorded too.
+    bool shared = members.size() > 1;
+    bool recorded = shared || !this->cnf.dimacs_prefix.empty() || !this->cnf.external_solver.empty();
+    BackendSink backend(shared ? std::vector<SatBackend*>() : members);
+    DimacsSink dimacs(&backend);
+    CnfSink& sink = recorded ? static_cast<CnfSink&>(dimacs) : static_cast<CnfSink&>(backend);
+
+    // vars[v * width .. (v + 1) * width): the literals of which any one
+    // puts v in the cover
+    // vertex[v]: the one variable that says so, if the encoding has it
+    std::vector<Minisat::Lit> vertex;
+    size_t width = slots ? (size_t)k : 1;
+
+    // encoding, loading into the solver included: CPU time and the time
+    // it took
+    struct timespec c1, c2, w1, w2;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &c1);
+    clock_gettime(CLOCK_MONOTONIC, &w1);
+    std::vector<Minisat::Lit> vars = slots ? this->encode_slots(g, k, sink, vertex) : this->encode_direct(g, k, sink, vertex);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &c2);
+    clock_gettime(CLOCK_MONOTONIC, &w2);
+
+    stats_add("sat.vars", backend.vars());
+    stats_add("sat.clauses", backend.clauses());
+    stats_add("sat.encode_time", (c2.tv_sec - c1.tv_sec) + (c2.tv_nsec - c1.tv_nsec) / 1e9);
+    stats_add("sat.encode_wall", (w2.tv_sec - w1.tv_sec) + (w2.tv_nsec - w1.tv_nsec) / 1e9);
+
+    std::string file;
+    if(!this->cnf.dimacs_prefix.empty()) {
+        file = this->cnf.dimacs_prefix + "-k" + std::to_string(k) + ".cnf";
+
+        std::vector<std::string> comments;
+        comments.push_back("vertex cover of size " + std::to_string(k) + ", " + std::to_string(N) + " vertices, "
+                           + std::to_string(g.get_edges().size()) + " edges, " + cardinality_name(this->cnf.cardinality) + " encoding");
+        comments.push_back("vertex v is in the cover if any of its variables is true");
+        for(size_t v = 0; v < N; v++) {
+            std::string line = "vertex " + std::to_string(v) + ":";
+            for(size_t j = v * width; j < (v + 1) * width; j++)
+                line += " " + std::to_string(Minisat::var(vars[j]) + 1);
+            comments.push_back(line);
+        }
+
+        std::ofstream out(file);
+        dimacs.write(out, comments);
+        if(!out) {
+            std::cerr << "Error: cannot write " << file << "." << std::endl;
+            file.clear();
+        }
+    }
+
+    // value of every variable in the model
+    std::vector<bool> value;
+    std::vector<int> cover;
+    bool res = false, solved = false;
+    if(!this->cnf.external_solver.empty()) {
+        solved = dimacs.solve(this->cnf.external_solver, file, res, value);
+        if(solved && res)
+            cover = read_cover(value, vars, N, width);
+
+        // a model is only taken if the cover in it holds up
+        if(!solved) {
+            std::cerr << "Error: no answer from " << this->cnf.external_solver << ", solving with " << solver->signature() << "." << std::endl;
+        } else if(res && !check_cover(g, k, cover)) {
+            std::cerr << "Error: " << this->cnf.external_solver << " gave no cover of at most " << k << " vertices, solving with " << solver->signature() << "." << std::endl;
+            solved = false;
+            res = false;
+        } else {
+            stats_add("sat.external", 1);
+        }
+    }
+
+    if(!solved) {
+        // a worker per cube left after pruning at most; the others would
+        // load the CNF for nothing
+        std::vector<std::vector<int>> cubes;
+        bool cubing = depth > 0 && !vertex.empty();
+        if(cubing) {
+            size_t pruned;
+            cubes = make_cubes(g, k, split_vertices(g, depth), vertex, pruned);
+            stats_add("sat.cubes", cubes.size());
+            stats_add("sat.cubes_pruned", pruned);
+
+            size_t workers = std::min(members.size(), std::max(cubes.size(), (size_t)1));
+            solvers.resize(workers);
+            members.resize(workers);
+        }
+
+        if(shared) {
+            struct timespec c3, c4, w3, w4;
+            double loading = parallel_cpu();
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &c3);
+            clock_gettime(CLOCK_MONOTONIC, &w3);
+            parallel_for(members.size(), [&](size_t i) {
+                dimacs.load(*members[i]);
+            });
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &c4);
+            clock_gettime(CLOCK_MONOTONIC, &w4);
+
+            stats_add("sat.encode_time", (c4.tv_sec - c3.tv_sec) + (c4.tv_nsec - c3.tv_nsec) / 1e9 + parallel_cpu() - loading);
+            stats_add("sat.encode_wall", (w4.tv_sec - w3.tv_sec) + (w4.tv_nsec - w3.tv_nsec) / 1e9);
+        }
+
+        // preprocessing may eliminate anything but the per-vertex variables
+        parallel_for(members.size(), [&](size_t i) {
+            if(!hint.empty())
+                warm_start(*members[i], g, k, hint, vars, slots);
+            for(Minisat::Lit l: vertex)
+                members[i]->freeze(Minisat::var(l) + 1);
+            members[i]->preprocess();
+        });
+
+        struct timespec t1, t2;
+        double pool = parallel_cpu();
+        int status = 0;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t1);
+        if(cubing) {
+            int winner = cube_solve(solvers, cubes, status);
+            if(winner >= 0)
+                solver = members[winner];
+        } else if(members.size() > 1) {
+            int winner = portfolio_solve(solvers, status);
+            if(winner >= 0)
+                solver = members[winner];
+        } else {
+            status = solver->solve();
+        }
+        res = status == 10;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t2);
+
+        long conflicts = 0;
+        for(SatBackend *member: members)
+            conflicts += member->conflicts();
+        stats_add("sat.conflicts", conflicts);
+        stats_add("sat.solve_time", (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9 + parallel_cpu() - pool);
+        value.assign(backend.vars(), false);
+        if(res)
+            for(int v = 0; v < backend.vars(); v++)
+                value[v] = solver->val(v + 1) > 0;
+        cover = res ? read_cover(value, vars, N, width) : std::vector<int>{};
+    }
+
     return std::make_pair(res, cover);
 }
@@ -2,20 +2,82 @@
 #ifndef _COVER_HPP
 #define _COVER_HPP
 
+#include <functional>
+#include <string>
 #include <vector>
 
 #include "graph.hpp"
+#include "cardinality.hpp"
+#include "satbackend.hpp"
+
+// Called by the anytime solvers with every better cover they find and the
+// best lower bound they know; the cover is empty when only the bound moved.
+typedef std::function<void(const std::vector<int>& cover, int lower)> vc_progress;
+
+// Cube-and-conquer makes up to 2^depth cubes; deeper splits are cut to this.
+const int MAX_CUBE_DEPTH = 20;
+
+// Options of the CNF encoding of vc_cnf_sat.
+struct cnf_options {
+    // positions hold vertices in increasing order, one model per cover
+    bool break_positions;
+
+    // vertex permutations of the graph whose lex-leader constraints are added
+    std::vector<std::vector<int>> automorphisms;
+
+    // CARD_SLOTS is the k-slot encoding; any other encoding states the
+    // problem with one variable per vertex under that at-most-k encoding
+    cardinality_encoding cardinality;
+
+    // if set, every CNF is also written to DIMACS_PREFIX-kK.cnf
+    std::string dimacs_prefix;
+
+    // if set, a solver binary given the DIMACS file solves it instead of
+    // the backend, which is the fallback when it gives no answer
+    std::string external_solver;
+
+    // the solver linked in
+    sat_backend backend;
+
+    // more than 1: that many differently configured backends, one per CPU
+    // at most, race on every k, sharing short learnt clauses
+    int portfolio;
+
+    // more than 0: cube-and-conquer on every k, branching on up to that many
+    // vertices (MAX_CUBE_DEPTH at most), with one worker per CPU, or per
+    // cube if there are fewer, instead of a portfolio
+    int cube_depth;
+
+    cnf_options(): break_positions(false), cardinality(CARD_SLOTS), backend(SAT_MINISAT), portfolio(1), cube_depth(0) {}
+};
 
 class VCSolver {
 private:
 
+   cnf_options cnf;
+
+   // the literals that put each vertex in the cover, vertex by vertex in
+   // one array: x[v][1..k], or x[v]; vertex gets one variable per vertex if
+   // the encoding has them
+   std::vector<Minisat::Lit> encode_slots(Graph& g, int k, CnfSink& sink, std::vector<Minisat::Lit>& vertex);
+   std::vector<Minisat::Lit> encode_direct(Graph& g, int k, CnfSink& sink, std::vector<Minisat::Lit>& vertex);
+
     public:
-	VCSolver();
+	VCSolver(const cnf_options& cnf = cnf_options());
    ~VCSolver();
 
-   std::pair<bool, std::vector<int>> vc_cnf_sat(Graph g, int k);
+   // hint, a known cover, only guides the solver's first decisions
+   std::pair<bool, std::vector<int>> vc_cnf_sat(Graph g, int k, const std::vector<int>& hint = std::vector<int>{});
+   std::pair<bool, std::vector<int>> vc_decide(Graph g, int k);
    std::pair<bool, std::vector<int>> vc_approx_1(Graph g);
    std::pair<bool, std::vector<int>> vc_approx_2(Graph g);
+   std::pair<bool, std::vector<int>> vc_prune(Graph g, const std::vector<int>& cover);
+   std::pair<bool, std::vector<int>> vc_bnb(Graph g, const vc_progress& progress = vc_progress());
+   std::pair<bool, std::vector<int>> vc_small(Graph g);
+   std::pair<bool, std::vector<int>> vc_bipartite(Graph g);
+   std::pair<bool, std::vector<int>> vc_forest(Graph g);
+   std::pair<bool, std::vector<int>> vc_treewidth(Graph g, int max_width);
+   std::pair<bool, std::vector<int>> vc_local_search(Graph g, double seconds, const vc_progress& progress = vc_progress());
 };
 
 #endif
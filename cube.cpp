@@ -0,0 +1,114 @@
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "cube.hpp"
+#include "pool.hpp"
+#include "stats.hpp"
+
+struct cube_context {
+    // Context
+    pthread_mutex_t                  mutex;
+    std::atomic<size_t>               next;
+    std::atomic<int>                winner;
+    std::atomic<bool>             refuted;
+    // the failed assumptions of every refuted cube, sorted
+    std::vector<std::vector<int>>   cores;
+    // Input
+    const std::vector<std::vector<int>> *cubes;
+    // Output
+    std::atomic<long>             solved;
+    std::atomic<long>            skipped;
+};
+
+// whether a refutation found so far covers the cube (sorted)
+static bool refuted_before(struct cube_context *ctx, const std::vector<int>& cube) {
+
+    pthread_mutex_lock(&ctx->mutex);
+    bool covered = false;
+    for(size_t i = 0; i < ctx->cores.size() && !covered; i++)
+        covered = std::includes(cube.begin(), cube.end(), ctx->cores[i].begin(), ctx->cores[i].end());
+    pthread_mutex_unlock(&ctx->mutex);
+
+    return covered;
+}
+
+static void conquer(struct cube_context *ctx, SatBackend& solver, int member) {
+
+    for(size_t c = ctx->next++; c < ctx->cubes->size(); c = ctx->next++) {
+        if(ctx->winner >= 0 || ctx->refuted)
+            return;
+
+        std::vector<int> cube = (*ctx->cubes)[c];
+        std::sort(cube.begin(), cube.end());
+        if(refuted_before(ctx, cube)) {
+            ctx->skipped++;
+            continue;
+        }
+
+        for(int l: cube)
+            solver.assume(l);
+        int answer = solver.solve();
+        ctx->solved++;
+
+        if(answer == 10) {
+            int none = -1;
+            ctx->winner.compare_exchange_strong(none, member);
+            return;
+        }
+
+        if(answer == 20) {
+            std::vector<int> core;
+            for(int l: cube)
+                if(solver.failed(l))
+                    core.push_back(l);
+
+            if(core.empty()) {
+                ctx->refuted = true;
+                return;
+            }
+
+            pthread_mutex_lock(&ctx->mutex);
+            ctx->cores.push_back(core);
+            pthread_mutex_unlock(&ctx->mutex);
+        }
+    }
+}
+
+int cube_solve(std::vector<std::unique_ptr<SatBackend>>& backends, const std::vector<std::vector<int>>& cubes, int& status) {
+
+    struct cube_context ctx;
+    pthread_mutex_init(&ctx.mutex, NULL);
+    ctx.next = 0;
+    ctx.winner = -1;
+    ctx.refuted = false;
+    ctx.cubes = &cubes;
+    ctx.solved = 0;
+    ctx.skipped = 0;
+
+    for(size_t i = 0; i < backends.size(); i++) {
+        backends[i]->set_terminate([&ctx]() {
+            return ctx.winner >= 0 || ctx.refuted;
+        });
+    }
+
+    parallel_for(backends.size(), [&](size_t i) {
+        conquer(&ctx, *backends[i], i);
+    });
+
+    // the callbacks point into this frame
+    for(size_t i = 0; i < backends.size(); i++)
+        backends[i]->set_terminate(nullptr);
+    pthread_mutex_destroy(&ctx.mutex);
+
+    stats_add("sat.cubes_solved", ctx.solved);
+    stats_add("sat.cubes_skipped", ctx.skipped);
+
+    // no model and nothing left open: every cube is refuted
+    status = ctx.winner >= 0 ? 10 : 20;
+    return ctx.winner;
+}
@@ -0,0 +1,20 @@
+
+#ifndef _CUBE_HPP
+#define _CUBE_HPP
+
+#include <memory>
+#include <vector>
+
+#include "satbackend.hpp"
+
+// The conquer half of cube-and-conquer. Every backend holds the same CNF and
+// works on the pool, taking cubes (assumptions, in DIMACS) one after another
+// and solving under them incrementally. The first satisfiable cube stops all
+// of them. An unsatisfiable cube leaves the assumptions the refutation used,
+// and cubes containing those are skipped; if it used none, the CNF itself is
+// unsatisfiable. Returns the index of the backend that found a model, or -1,
+// and 10, or 20 once every cube is refuted, in status. The backends' own
+// terminate is replaced.
+int cube_solve(std::vector<std::unique_ptr<SatBackend>>& backends, const std::vector<std::vector<int>>& cubes, int& status);
+
+#endif
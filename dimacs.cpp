@@ -0,0 +1,172 @@
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dimacs.hpp"
+
+DimacsSink::DimacsSink(CnfSink *next) {
+
+    this->next = next;
+    this->nvars = 0;
+    this->nclauses = 0;
+}
+
+Minisat::Lit DimacsSink::fresh() {
+
+    if(this->next == nullptr)
+        return Minisat::mkLit(this->nvars++);
+
+    Minisat::Lit l = this->next->fresh();
+    this->nvars = std::max(this->nvars, Minisat::var(l) + 1);
+    return l;
+}
+
+void DimacsSink::add(const Minisat::Lit *clause, size_t size) {
+
+    for(size_t i = 0; i < size; i++)
+        this->literals.push_back(Minisat::sign(clause[i]) ? -(Minisat::var(clause[i]) + 1) : Minisat::var(clause[i]) + 1);
+    this->literals.push_back(0);
+    this->nclauses += 1;
+
+    if(this->next != nullptr)
+        this->next->add(clause, size);
+}
+
+void DimacsSink::reserve(size_t vars, size_t clauses, size_t literals) {
+
+    this->literals.reserve(this->literals.size() + literals + clauses);
+
+    if(this->next != nullptr)
+        this->next->reserve(vars, clauses, literals);
+}
+
+void DimacsSink::write(std::ostream& out, const std::vector<std::string>& comments) const {
+
+    for(auto const& c: comments)
+        out << "c " << c << "\n";
+    out << "p cnf " << this->nvars << " " << this->nclauses << "\n";
+
+    for(size_t i = 0; i < this->literals.size(); i++)
+        out << this->literals[i] << (this->literals[i] == 0 ? "\n" : " ");
+}
+
+void DimacsSink::load(SatBackend& backend) const {
+
+    for(size_t i = 0; i < this->literals.size(); i++) {
+        backend.add(this->literals[i]);
+        if(i % 65536 == 0)
+            pthread_testcancel();
+    }
+}
+
+// what a cancelled thread leaves behind
+struct external_run {
+    pid_t               pid;
+    int                  fd;
+    const char   *temporary;
+};
+
+static void abandon_external_run(void *arg) {
+
+    struct external_run *run = (struct external_run *)arg;
+    kill(-run->pid, SIGKILL);
+    waitpid(run->pid, NULL, 0);
+    close(run->fd);
+    if(run->temporary != NULL)
+        unlink(run->temporary);
+}
+
+bool DimacsSink::solve(const std::string& command, const std::string& file, bool& sat, std::vector<bool>& model) const {
+
+    std::string path = file;
+    char temporary[] = "/tmp/ece650-prj-XXXXXX";
+    if(path.empty()) {
+        int fd = mkstemp(temporary);
+        if(fd == -1)
+            return false;
+        close(fd);
+
+        path = temporary;
+        std::ofstream out(path);
+        this->write(out, std::vector<std::string>{});
+    }
+
+    // everything the child needs is ready before the fork
+    std::string line = command + " '" + path + "'";
+    int fd[2];
+    if(pipe(fd) != 0)
+        return false;
+
+    pid_t pid = fork();
+    if(pid == 0) {
+        // its own process group, so that whatever the shell starts dies with it
+        setpgid(0, 0);
+        dup2(fd[1], STDOUT_FILENO);
+        close(fd[0]);
+        close(fd[1]);
+        execl("/bin/sh", "sh", "-c", line.c_str(), (char *)NULL);
+        _exit(127);
+    }
+    close(fd[1]);
+    if(pid < 0) {
+        close(fd[0]);
+        return false;
+    }
+    setpgid(pid, pid);
+
+    struct external_run run = { pid, fd[0], file.empty() ? temporary : NULL };
+    std::string output;
+    char buffer[4096];
+    ssize_t n;
+
+    // waitpid is a cancellation point too: the child is reaped either way
+    int status;
+    pthread_cleanup_push(abandon_external_run, &run);
+    while((n = read(fd[0], buffer, sizeof(buffer))) > 0)
+        output.append(buffer, n);
+    waitpid(pid, &status, 0);
+    pthread_cleanup_pop(0);
+
+    close(fd[0]);
+    if(file.empty())
+        unlink(temporary);
+
+    bool answered = false;
+    bool has_model = false;
+    model.assign(this->nvars, false);
+
+    std::istringstream lines(output);
+    std::string text;
+    while(std::getline(lines, text)) {
+        if(text.compare(0, 2, "s ") == 0) {
+            // "s UNKNOWN" is no answer
+            bool unsat = text.find("UNSATISFIABLE") != std::string::npos;
+            sat = !unsat && text.find("SATISFIABLE") != std::string::npos;
+            answered = sat || unsat;
+        } else if(text.compare(0, 2, "v ") == 0) {
+            std::istringstream values(text.substr(2));
+            int l;
+            while(values >> l) {
+                if(l != 0 && abs(l) <= this->nvars)
+                    model[abs(l) - 1] = l > 0;
+                has_model = true;
+            }
+        }
+    }
+
+    if(!answered && WIFEXITED(status) && (WEXITSTATUS(status) == 10 || WEXITSTATUS(status) == 20)) {
+        answered = true;
+        sat = WEXITSTATUS(status) == 10;
+    }
+
+    return answered && (!sat || has_model);
+}
@@ -0,0 +1,62 @@
+
+#ifndef _DIMACS_HPP
+#define _DIMACS_HPP
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "cardinality.hpp"
+#include "satbackend.hpp"
+
+// Records a CNF as it is built, passing every variable and clause on to
+// another sink if there is one, so it can be written in DIMACS or handed to
+// an external solver. Variables keep the numbers the other sink gave them
+// (plus one, as DIMACS counts from 1).
+class DimacsSink: public CnfSink {
+
+    private:
+
+        CnfSink *next;
+        int nvars;
+        int nclauses;
+
+        // DIMACS literals, each clause ended by 0
+        std::vector<int> literals;
+
+    public:
+
+        DimacsSink(CnfSink *next = nullptr);
+
+        using CnfSink::add;
+
+        Minisat::Lit fresh();
+        void add(const Minisat::Lit *clause, size_t size);
+        void reserve(size_t vars, size_t clauses, size_t literals);
+
+        int vars() const {
+            return this->nvars;
+        }
+
+        int clauses() const {
+            return this->nclauses;
+        }
+
+        // adds every clause recorded so far to backend; safe to run for
+        // several backends at once
+        void load(SatBackend& backend) const;
+
+        // comments go first, one "c" line each
+        void write(std::ostream& out, const std::vector<std::string>& comments) const;
+
+        // Runs "command FILE" through the shell, FILE being file if the CNF
+        // was written there or else a temporary copy removed afterwards, and
+        // reads a SAT competition style answer from its output: an "s
+        // SATISFIABLE" or "s UNSATISFIABLE" line, or else exit status 10 or
+        // 20, and "v" lines with the model. model[v] is the value of
+        // variable v in MiniSat's numbering. False if the solver did not
+        // answer. A cancelled thread kills the solver.
+        bool solve(const std::string& command, const std::string& file, bool& sat, std::vector<bool>& model) const;
+};
+
+#endif
@@ -0,0 +1,128 @@
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "dispatch.hpp"
+
+graph_features compute_features(const Graph& g) {
+
+    graph_features f;
+    f.vertices = g.vs();
+    f.edges = 0;
+    f.max_degree = 0;
+
+    int **m = g.adjmat();
+    for(int v1 = 0; v1 < f.vertices; v1++) {
+        int degree = 0;
+        for(int v2 = 0; v2 < f.vertices; v2++)
+            if(m[v1][v2] == 1)
+                degree++;
+
+        f.edges += degree;
+        f.max_degree = std::max(f.max_degree, degree);
+    }
+    f.edges /= 2;
+
+    f.density = f.vertices > 1 ? 2.0 * f.edges / ((double)f.vertices * (f.vertices - 1)) : 0;
+    f.components = g.get_components().size();
+    f.bipartite = g.is_bipartite();
+    f.forest = f.edges == f.vertices - f.components;
+    f.too_wide = false;
+
+    return f;
+}
+
+std::string exact_method_name(exact_method method) {
+
+    switch(method) {
+        case EXACT_NONE:      return "none";
+        case EXACT_FOREST:    return "forest";
+        case EXACT_BIPARTITE: return "bipartite";
+        case EXACT_KERNEL:    return "kernel";
+        case EXACT_TREEDP:    return "treedp";
+        case EXACT_MASK:      return "mask";
+        case EXACT_BNB:       return "bnb";
+        case EXACT_SAT:       return "sat";
+        case EXACT_FPT:       return "fpt";
+    }
+
+    return "unknown";
+}
+
+exact_method select_exact_method(const graph_features& f, bool kernelized, const std::string& forced, std::string& reason) {
+
+    std::ostringstream why;
+
+    if(f.edges == 0) {
+        reason = "no edges";
+        return EXACT_NONE;
+    }
+
+    // honour a forced method as long as it can solve this graph
+    if(forced == "forest" && f.forest) {
+        reason = "forced";
+        return EXACT_FOREST;
+    } else if(forced == "bipartite" && f.bipartite) {
+        reason = "forced";
+        return EXACT_BIPARTITE;
+    } else if(forced == "mask" && f.vertices <= 128) {
+        reason = "forced";
+        return kernelized ? EXACT_MASK : EXACT_KERNEL;
+    } else if((forced == "treedp" && !f.too_wide) || forced == "bnb" || forced == "sat" || forced == "fpt") {
+        reason = "forced";
+        if(!kernelized)
+            return EXACT_KERNEL;
+        if(forced == "treedp")
+            return EXACT_TREEDP;
+        return forced == "bnb" ? EXACT_BNB : (forced == "sat" ? EXACT_SAT : EXACT_FPT);
+    } else if(forced != "auto" && !forced.empty()) {
+        why << "forced " << forced << " does not apply, ";
+    }
+
+    if(f.forest) {
+        why << "acyclic, leaf rule is exact";
+        reason = why.str();
+        return EXACT_FOREST;
+    }
+
+    if(f.bipartite) {
+        why << "bipartite, Koenig cover from a maximum matching";
+        reason = why.str();
+        return EXACT_BIPARTITE;
+    }
+
+    if(!kernelized) {
+        why << "no special class, reducing first";
+        reason = why.str();
+        return EXACT_KERNEL;
+    }
+
+    if(f.vertices <= 128) {
+        why << f.vertices << " vertices fit in " << (f.vertices <= 64 ? "one word" : "two words");
+        reason = why.str();
+        return EXACT_MASK;
+    }
+
+    // sparse graphs tend to have narrow decompositions; the DP falls back
+    // to the next choice when the decomposition is too wide
+    if(f.edges <= 2 * f.vertices && !f.too_wide) {
+        why << "sparse (" << f.edges << " edges on " << f.vertices << " vertices), trying tree decomposition";
+        reason = why.str();
+        return EXACT_TREEDP;
+    }
+
+    if(f.vertices <= 300) {
+        if(f.too_wide)
+            why << "no narrow decomposition, ";
+        why << f.vertices << " vertices, max degree " << f.max_degree << ", in branch and bound range";
+        reason = why.str();
+        return EXACT_BNB;
+    }
+
+    if(f.too_wide)
+        why << "no narrow decomposition, ";
+    why << f.vertices << " vertices, density " << f.density << ", too large for branch and bound";
+    reason = why.str();
+    return EXACT_SAT;
+}
@@ -0,0 +1,47 @@
+
+#ifndef _DISPATCH_HPP
+#define _DISPATCH_HPP
+
+#include <string>
+
+#include "graph.hpp"
+
+// Cheap structural features, all computed in one pass over the graph.
+struct graph_features {
+    int       vertices;
+    int          edges;
+    double     density;
+    int     max_degree;
+    int     components;
+    bool     bipartite;
+    bool        forest;
+    // set by the caller once the DP found no decomposition narrow enough
+    bool      too_wide;
+};
+
+enum exact_method {
+    EXACT_NONE,
+    EXACT_FOREST,
+    EXACT_BIPARTITE,
+    EXACT_KERNEL,
+    EXACT_TREEDP,
+    EXACT_MASK,
+    EXACT_BNB,
+    EXACT_SAT,
+    EXACT_FPT
+};
+
+graph_features compute_features(const Graph& g);
+
+// Picks the exact method expected to be fastest for a graph with these
+// features and explains why in reason. Polynomial special classes win,
+// anything else is first handed to the kernel (EXACT_KERNEL); on a kernel
+// the choice is among the tree decomposition DP, the mask solver, branch
+// and bound and SAT. A forced method ("sat", "bnb", ...) is honoured when it
+// applies to the graph, "auto" leaves the choice to the features. The
+// bounded search tree ("fpt") is only ever forced.
+exact_method select_exact_method(const graph_features& f, bool kernelized, const std::string& forced, std::string& reason);
+
+std::string exact_method_name(exact_method method);
+
+#endif
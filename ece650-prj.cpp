@@ -7,6 +7,7 @@
 #include <execinfo.h>
 
 #include <array>
+#include <atomic>
 #include <vector>
 #include <utility>
 #include <iostream>
@@ -17,6 +18,12 @@
 #include "parse.hpp"
 #include "graph.hpp"
 #include "cover.hpp"
+#include "kernel.hpp"
+#include "automorphism.hpp"
+#include "dispatch.hpp"
+#include "pool.hpp"
+#include "progress.hpp"
+#include "stats.hpp"
 
 void default_signal_handler(int sig) {
     void *buffer[15];
@@ -30,39 +37,106 @@ const int WATCHDOG      = 0;
 const int CNF_SAT_VC    = 1;
 const int APPROX_VC_1   = 2;
 const int APPROX_VC_2   = 3;
+const int BNB_VC        = 4;
+const int LS_VC         = 5;
+const int APPROX_VC_1_PRUNED = 6;
+const int APPROX_VC_2_PRUNED = 7;
+
+// number of vertex cover algorithms, each on its own thread next to the watchdog
+const int NALGO         = 7;
+
+// algorithms cancelled once another one finds a cover of lower bound size
+const int EXACT[]       = { CNF_SAT_VC, BNB_VC };
+
+// algorithms whose cover size the benchmark compares against the exact one
+const int APPROX[]      = { APPROX_VC_1, APPROX_VC_2, LS_VC, APPROX_VC_1_PRUNED, APPROX_VC_2_PRUNED };
+
+// time of an exact algorithm that was stopped because another one met the
+// lower bound; its cover is that one's, and it is printed as skipped
+const double SKIPPED    = -2;
+
+// widest tree decomposition the exact path runs its DP on (2^w table entries per bag)
+const int TREEDP_WIDTH  = 12;
+
+struct options {
+    bool            benchmark_mode;
+    bool                index_mode;
+    // print each algorithm's covers as they are found instead of at the end
+    bool               stream_mode;
+    // MiniSat without the phases and decision order taken from a heuristic cover
+    bool                cold_start;
+    // additions to the CNF encoding
+    cnf_options                cnf;
+    // lex-leader constraints for the generators of the graph's automorphisms
+    bool       break_automorphisms;
+    // directory that receives every CNF handed to the SAT solver
+    std::string         dimacs_dir;
+    int            timeout_seconds;
+    // exact method behind CNF-SAT-VC, "auto" picks one from graph features
+    std::string              exact;
+    // time the local search keeps improving its cover, and when that ends
+    double           local_seconds;
+    struct timespec local_deadline;
+};
 
 struct thread_context { 
     // Context
-    pthread_t             thread[4] = {};
+    pthread_t             thread[NALGO + 1] = {};
     pthread_mutex_t         *mutex; 
     int                      count;
+    bool          done[NALGO + 1] = {};
     // Input
-    uint                   timeout;
+    struct options            opts;
     Graph                        g;
+    // size of a maximal matching, which no cover can be smaller than
+    int                lower_bound;
+    // first cover found of that size, which makes the exact threads moot
+    int                  proven_by;
+    std::vector<int>        proven;
 };
-std::string ALGO[] = { "CNF-SAT-VC", "APPROX-VC-1", "APPROX-VC-2" };
+std::string ALGO[] = { "CNF-SAT-VC", "APPROX-VC-1", "APPROX-VC-2", "BNB-VC", "LS-VC", "APPROX-VC-1-PRUNED", "APPROX-VC-2-PRUNED" };
 
 void        cleanup_vc_thread(void* arg);
 void *        watchdog_thread(void *arg);
 void *      cnf_sat_vc_thread(void *arg);
 void *     approx_vc_1_thread(void *arg);
 void *     approx_vc_2_thread(void *arg);
+void *          bnb_vc_thread(void *arg);
+void *           ls_vc_thread(void *arg);
+void * approx_vc_1_pruned_thread(void *arg);
+void * approx_vc_2_pruned_thread(void *arg);
+
+typedef std::vector<int> (*vc_impl)(Graph& g, const struct options& opts, const vc_progress& progress);
 
-std::pair<std::vector<int>, double>  cnf_sat_vc_impl(Graph& g, int k);
-std::pair<std::vector<int>, double> approx_vc_1_impl(Graph& g, int k);
-std::pair<std::vector<int>, double> approx_vc_2_impl(Graph& g, int k);
+std::vector<int>  cnf_sat_vc_impl(Graph& g, const struct options& opts, const vc_progress& progress);
+std::vector<int> approx_vc_1_impl(Graph& g, const struct options& opts, const vc_progress& progress);
+std::vector<int> approx_vc_2_impl(Graph& g, const struct options& opts, const vc_progress& progress);
+std::vector<int>      bnb_vc_impl(Graph& g, const struct options& opts, const vc_progress& progress);
+std::vector<int>       ls_vc_impl(Graph& g, const struct options& opts, const vc_progress& progress);
+std::vector<int> approx_vc_1_pruned_impl(Graph& g, const struct options& opts, const vc_progress& progress);
+std::vector<int> approx_vc_2_pruned_impl(Graph& g, const struct options& opts, const vc_progress& progress);
+
+std::vector<int> solve_by_component(const Graph& g, vc_impl solve, const struct options& opts, Progress& progress, double& cpu);
 
 Graph read_in();
-void parse_arguments(int argc, char* argv[], bool&, int& timeout);
-std::array<std::pair<std::vector<int>, double>, 3> process_in_parallel(const Graph& g, int timeout);
+int matching_lower_bound(Graph g);
+void parse_arguments(int argc, char* argv[], struct options& opts);
+std::array<std::pair<std::vector<int>, double>, NALGO> process_in_parallel(const Graph& g, const struct options& opts);
 
 int main(int argc, char** argv) {
     
     signal(SIGSEGV, default_signal_handler);
 
-    bool benchmark_mode = false;
-    int  timeout_seconds = 120;
-    parse_arguments(argc, argv, benchmark_mode, timeout_seconds);
+    struct options opts;
+    opts.benchmark_mode = false;
+    opts.index_mode = false;
+    opts.stream_mode = false;
+    opts.cold_start = false;
+    opts.break_automorphisms = false;
+    opts.timeout_seconds = 120;
+    opts.exact = "auto";
+    opts.local_seconds = 2;
+    parse_arguments(argc, argv, opts);
     
     while(!std::cin.eof()) {
         
@@ -71,40 +145,63 @@ int main(int argc, char** argv) {
 	    if(!g.initialized())
 	        continue;
 
-        std::array<std::pair<std::vector<int>, double>, 3> output = process_in_parallel(g, timeout_seconds);
+        if(opts.index_mode) {
+            g.build_index();
+
+            const PathIndex *index = g.path_index();
+            std::cerr << "Index: " << index->label_entries() << " labels, "
+                      << index->memory_usage() << " bytes, "
+                      << std::fixed << std::setprecision(6) << index->build_time() << " s"
+                      << std::endl;
+        }
+
+        std::array<std::pair<std::vector<int>, double>, NALGO> output = process_in_parallel(g, opts);
         
-        for(size_t i = 0; i < 3; i++) {
-            if(benchmark_mode) {
-                if(output[i].second != -1)
+        if(opts.benchmark_mode) {
+            for(size_t i = 0; i < NALGO; i++) {
+                if(output[i].second == SKIPPED)
+                    std::cout << "skipped";
+                else if(output[i].second != -1)
                     std::cout << std::fixed << std::setprecision(6) << output[i].second;
                 else
                     std::cout << "timeout";
                 
                 std::cout << ",";
+            }
+
+            // approximation ratios against whichever exact algorithm finished;
+            // a skipped one still holds a cover of lower bound size
+            int exact = -1;
+            if(output[CNF_SAT_VC - 1].second != -1)
+                exact = CNF_SAT_VC - 1;
+            else if(output[BNB_VC - 1].second != -1)
+                exact = BNB_VC - 1;
+
+            for(size_t i = 0; i < sizeof(APPROX) / sizeof(APPROX[0]); i++) {
+                int a = APPROX[i] - 1;
+
+                if(i > 0)
+                    std::cout << ",";
+
+                if(exact != -1 && output[exact].first.size() != 0 && output[a].second != -1)
+                    std::cout << std::fixed << std::setprecision(6) << output[a].first.size()/(double)output[exact].first.size();
+                else
+                    std::cout << "N/A";
+            }
+            std::cout << std::endl;
+        } else {
+            for(size_t i = 0; i < NALGO; i++) {
+
+                // streamed covers and skips are already out, only timeouts are left
+                if(opts.stream_mode && output[i].second != -1)
+                    continue;
 
-                if(i == 2) {
-                    if(output[0].second != -1 && output[0].first.size() != 0) {
-                        if(output[1].second != -1)
-                            std::cout << std::fixed << std::setprecision(6) << output[1].first.size()/(double)output[0].first.size();
-                        else
-                            std::cout << "N/A";
-
-                        std::cout << ",";
-
-                        if(output[2].second != -1)
-                            std::cout << std::fixed << std::setprecision(6) << output[2].first.size()/(double)output[0].first.size();
-                        else 
-                            std::cout << "N/A";
-                    } else {
-                        std::cout << "N/A" << "," << "N/A";
-                    }
-                    std::cout << std::endl;
-                }
-            } else {
                 std::cout << ALGO[i] << ": ";
 
                 if(output[i].second == -1) {
                     std::cout << "timeout" << std::endl;
+                } else if(output[i].second == SKIPPED) {
+                    std::cout << "skipped" << std::endl;
                 } else {
             
                     std::sort(output[i].first.begin(), output[i].first.end());
@@ -119,18 +216,70 @@ int main(int argc, char** argv) {
                 }
             }
         }
+
+        // solver measurements go to stderr to keep the benchmark csv intact
+        std::vector<std::pair<std::string, std::string>> stats = stats_take();
+        if(opts.benchmark_mode && !stats.empty()) {
+            for(size_t i = 0; i < stats.size(); i++)
+                std::cerr << (i > 0 ? "," : "") << stats[i].first << "=" << stats[i].second;
+            std::cerr << std::endl;
+        }
     }
 }
 
-void parse_arguments(int argc, char* argv[], bool& benchmark_mode, int& timeout_seconds) {
+void parse_arguments(int argc, char* argv[], struct options& opts) {
     char opt;
-    while((opt = getopt(argc, argv, "bo:t:")) != -1) {
+    while((opt = getopt(argc, argv, "aB:bC:cd:e:f:il:o:P:pst:x:")) != -1) {
         switch(opt) {
+            case 'a':
+                opts.break_automorphisms = true;
+                break;
             case 'b':
-                benchmark_mode = true;
+                opts.benchmark_mode = true;
+                break;
+            case 'B':
+                if(!parse_sat_backend(optarg, opts.cnf.backend))
+                    std::cerr << "Error: unknown SAT backend " << optarg << "." << std::endl;
+                break;
+            case 'C':
+                if(std::stoi(optarg) <= MAX_CUBE_DEPTH)
+                    opts.cnf.cube_depth = std::stoi(optarg);
+                else
+                    std::cerr << "Error: cube depth " << optarg << " is above " << MAX_CUBE_DEPTH << "." << std::endl;
+                break;
+            case 'c':
+                opts.cold_start = true;
+                break;
+            case 'd':
+                opts.dimacs_dir = optarg;
+                break;
+            case 'e':
+                opts.exact = optarg;
+                break;
+            case 'f':
+                if(!parse_cardinality(optarg, opts.cnf.cardinality))
+                    std::cerr << "Error: unknown cardinality encoding " << optarg << "." << std::endl;
+                break;
+            case 'i':
+                opts.index_mode = true;
+                break;
+            case 'P':
+                opts.cnf.portfolio = std::stoi(optarg);
+                break;
+            case 'p':
+                opts.cnf.break_positions = true;
+                break;
+            case 's':
+                opts.stream_mode = true;
+                break;
+            case 'l':
+                opts.local_seconds = std::stod(optarg);
                 break;
             case 't':
-                timeout_seconds = std::stoi(optarg);
+                opts.timeout_seconds = std::stoi(optarg);
+                break;
+            case 'x':
+                opts.cnf.external_solver = optarg;
                 break;
             default:
                 break;
@@ -207,28 +356,46 @@ Graph read_in () {
     return g;
 }
 
-std::array<std::pair<std::vector<int>, double>, 3> process_in_parallel(const Graph& g, int timeout) {
+std::array<std::pair<std::vector<int>, double>, NALGO> process_in_parallel(const Graph& g, const struct options& opts) {
 
     pthread_mutex_t mutex  = PTHREAD_MUTEX_INITIALIZER;
 
     struct thread_context ctx;
     ctx.mutex = &mutex;
-    ctx.timeout = timeout;
+    ctx.opts = opts;
     ctx.count = 0;
+    ctx.proven_by = -1;
+    ctx.lower_bound = matching_lower_bound(g);
+
+    // one deadline shared by the components the local search runs on
+    clock_gettime(CLOCK_MONOTONIC, &ctx.opts.local_deadline);
+    ctx.opts.local_deadline.tv_sec += (time_t)opts.local_seconds;
+    ctx.opts.local_deadline.tv_nsec += (long)((opts.local_seconds - (time_t)opts.local_seconds) * 1E9);
+    if(ctx.opts.local_deadline.tv_nsec >= 1000000000L) {
+        ctx.opts.local_deadline.tv_sec += 1;
+        ctx.opts.local_deadline.tv_nsec -= 1000000000L;
+    }
     ctx.g = g;
     
-    void* (*thread_run[])(void*) = { watchdog_thread, cnf_sat_vc_thread, approx_vc_1_thread, approx_vc_2_thread };
-    for (int i = 0; i < 4; i++) {
+    void* (*thread_run[])(void*) = { watchdog_thread, cnf_sat_vc_thread, approx_vc_1_thread, approx_vc_2_thread, bnb_vc_thread, ls_vc_thread,
+                                      approx_vc_1_pruned_thread, approx_vc_2_pruned_thread };
+    // a thread that finishes early may cancel others, all must exist by then
+    pthread_mutex_lock(&mutex);
+    for (int i = 0; i <= NALGO; i++) {
         pthread_create(&ctx.thread[i], NULL, thread_run[i], (void *)&ctx);
     }
+    pthread_mutex_unlock(&mutex);
 
-    std::array<std::pair<std::vector<int>, double>, 3> output = {};
-    for (int i = 0; i < 4; i++) {
+    std::array<std::pair<std::vector<int>, double>, NALGO> output = {};
+    for (int i = 0; i <= NALGO; i++) {
         
         void * retptr;
         pthread_join(ctx.thread[i], &retptr);
         if(i >= 1) {
-            if(retptr == PTHREAD_CANCELED) {
+            if(retptr == PTHREAD_CANCELED && ctx.done[i]) {
+                // stopped early: not its own answer, but still a minimum cover
+                output[i - 1] = std::make_pair(ctx.proven, SKIPPED);
+            } else if(retptr == PTHREAD_CANCELED) {
                 output[i - 1] = std::make_pair(std::vector<int>(), -1);
             } else {
                 std::pair<std::vector<int>, double> *resultptr = static_cast<std::pair<std::vector<int>, double>*>(retptr);
@@ -241,96 +408,277 @@ std::array<std::pair<std::vector<int>, double>, 3> process_in_parallel(const Gra
     return output;
 }
 
+int matching_lower_bound(Graph g) {
+
+    // every edge of a matching needs its own cover vertex
+    std::vector<bool> matched(g.vs(), false);
+    int size = 0;
+    for(auto const& e: g.get_edges()) {
+        if(!matched[e.first] && !matched[e.second]) {
+            matched[e.first] = matched[e.second] = true;
+            size++;
+        }
+    }
+
+    return size;
+}
+
+void finish_vc_thread(struct thread_context *ctx, int algo, const std::pair<std::vector<int>, double>& output) {
+
+    // called with ctx->mutex held
+    if(!ctx->done[algo]) {
+        ctx->done[algo] = true;
+        ctx->count += 1;
+    }
+
+    if(ctx->proven_by == -1 && (int)output.first.size() <= ctx->lower_bound) {
+
+        ctx->proven_by = algo;
+        ctx->proven = output.first;
+        stats_note("lower_bound.met_by", ALGO[algo - 1]);
+
+        for(int exact: EXACT) {
+            if(ctx->done[exact])
+                continue;
+
+            pthread_cancel(ctx->thread[exact]);
+            ctx->done[exact] = true;
+            ctx->count += 1;
+
+            if(ctx->opts.stream_mode && !ctx->opts.benchmark_mode)
+                std::cout << ALGO[exact - 1] << ": skipped" << std::endl;
+        }
+    }
+
+    if(ctx->count == NALGO) {
+        pthread_cancel(ctx->thread[WATCHDOG]);
+    }
+}
+
 double tdiff(struct timespec& t2, struct timespec& t1) {
     double diff = (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec)/1E9;
     return diff;
 }
 
-std::vector<int> cnf_sat_vc_impl(Graph& g) {
-    
-    for(int k = 1; k <= g.vs(); k++) {
-        VCSolver solver;
-        auto result = solver.vc_cnf_sat(g, k);
+std::vector<int> solve_by_component(const Graph& g, vc_impl solve, const struct options& opts, Progress& progress, double& cpu) {
+
+    // a minimum cover is the union of minimum covers of the connected
+    // components; isolated vertices are never part of it and are dropped
+    std::vector<std::vector<int>> components;
+    for(auto const& c: g.get_components())
+        if(c.size() > 1)
+            components.push_back(c);
+
+    progress.set_components(components);
+
+    std::vector<std::vector<int>> covers(components.size());
+    cpu = parallel_for(components.size(), [&](size_t i) {
+        Graph sub = g.induced_subgraph(components[i]);
+        for(int v: solve(sub, opts, progress.component(i)))
+            covers[i].push_back(components[i][v]);
+    });
+
+    std::vector<int> cover;
+    for(auto const& c: covers)
+        cover.insert(cover.end(), c.begin(), c.end());
+
+    return cover;
+}
+
+std::vector<int> cnf_sat_vc_sat(Graph& g, const struct options& opts, const vc_progress& progress) {
+
+    // the pruned approx-1 cover seeds every call, and once every k below its
+    // size is unsatisfiable it is the answer without another call
+    VCSolver heuristic;
+    std::vector<int> hint;
+    if(!opts.cold_start)
+        hint = heuristic.vc_prune(g, heuristic.vc_approx_1(g).second).second;
+
+    // the automorphisms do not depend on k: find them once for every call
+    cnf_options cnf = opts.cnf;
+    stats_note("sat.encoding", cardinality_name(cnf.cardinality));
+    stats_note("sat.backend", sat_backend_name(cnf.backend));
+
+    // one file per k: DIR/vcN-kK.cnf, N counting the graphs (and components) solved by SAT
+    static std::atomic<int> instances(0);
+    if(!opts.dimacs_dir.empty())
+        cnf.dimacs_prefix = opts.dimacs_dir + "/vc" + std::to_string(++instances);
+    if(opts.break_automorphisms) {
+        struct timespec t1, t2;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t1);
+        Automorphisms group(g);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t2);
+
+        cnf.automorphisms = group.generators();
+        stats_add("sym.generators", cnf.automorphisms.size());
+        stats_add("sym.nodes", group.explored());
+        stats_add("sym.time", tdiff(t2, t1));
+    }
+
+    for(int k = 0; k <= g.vs(); k++) {
+        if(!hint.empty() && k == (int)hint.size())
+            return hint;
+
+        VCSolver solver(cnf);
+        auto result = solver.vc_cnf_sat(g, k, hint);
         if(result.first)
             return result.second;
+
+        // no cover of size k: every cover has at least k + 1 vertices
+        if(progress)
+            progress(std::vector<int>{}, k + 1);
     }
 
     return std::vector<int>{};
 }
 
-void * cnf_sat_vc_thread (void *arg) {
+std::vector<int> cnf_sat_vc_fpt(Graph& g, const vc_progress& progress) {
 
-    struct thread_context *ctx = (struct thread_context *)arg;
-    std::pair<std::vector<int>, double> * output = new std::pair<std::vector<int>, double>{};
+    // the first k the bounded search tree accepts is the optimum; each call
+    // kernelizes again with k as the budget
+    VCSolver solver;
+    for(int k = 0; k <= g.vs(); k++) {
+        auto result = solver.vc_decide(g, k);
+        stats_add("fpt.calls", 1);
+        if(result.first)
+            return result.second;
+
+        if(progress)
+            progress(std::vector<int>{}, k + 1);
+    }
+
+    return std::vector<int>{};
+}
+
+std::vector<int> cnf_sat_vc_impl(Graph& g, const struct options& opts, const vc_progress& progress) {
     
-    int d;
-    pthread_cleanup_push(cleanup_vc_thread, output);
-    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &d);
-    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, &d);
+    // the cheapest exact method for the component, see select_exact_method()
+    VCSolver solver;
+    std::string reason;
+    graph_features f = compute_features(g);
+    exact_method method = select_exact_method(f, false, opts.exact, reason);
 
-    clockid_t cid;
-    struct timespec t1, t2;
-        pthread_getcpuclockid(pthread_self(), &cid);
-        
-        clock_gettime(cid, &t1);
-        output->first  = cnf_sat_vc_impl(ctx->g);
-        clock_gettime(cid, &t2);
-        output->second = tdiff(t2, t1);
+    if(method != EXACT_KERNEL)
+        stats_note("exact.method", exact_method_name(method) + ": " + reason);
 
-        pthread_mutex_lock(ctx->mutex);
-        ctx->count += 1;
-        if(ctx->count == 3) {
-            pthread_cancel(ctx->thread[WATCHDOG]);
-        }
-        pthread_mutex_unlock(ctx->mutex);
+    if(method == EXACT_NONE)
+        return std::vector<int>{};
+    if(method == EXACT_FOREST)
+        return solver.vc_forest(g).second;
+    if(method == EXACT_BIPARTITE)
+        return solver.vc_bipartite(g).second;
+
+    // everything else works on the kernel; approx-2 bounds the optimum for Buss' rule
+    std::vector<int> approx = solver.vc_approx_2(g).second;
+    Kernel kernel(g, approx.size());
+    Graph& reduced = kernel.graph();
+
+    // solvers on the kernel report in its numbering and without the offset
+    vc_progress lifted;
+    if(progress) {
+        progress(approx, kernel.lower_bound());
+        lifted = [&](const std::vector<int>& cover, int lower) {
+            progress(cover.empty() ? cover : kernel.lift(cover), lower + kernel.offset());
+        };
+    }
 
-        pthread_cleanup_pop(0);
-        pthread_exit(output);
+    // the LP bound may already prove the approximation optimal
+    if(approx.size() <= (size_t)kernel.lower_bound()) {
+        stats_note("exact.method", "approx-2: meets the LP bound");
+        return approx;
     }
 
+    stats_add("kernel.vertices", reduced.vs());
+    stats_add("kernel.lp_bound", kernel.lower_bound());
+    stats_add("kernel.match_time", kernel.match_time());
+
+    graph_features kf = compute_features(reduced);
+    method = select_exact_method(kf, true, opts.exact, reason);
+
+    std::vector<int> cover;
+    if(method == EXACT_TREEDP) {
+        auto dp = solver.vc_treewidth(reduced, TREEDP_WIDTH);
+        if(dp.first) {
+            cover = dp.second;
+        } else {
+            kf.too_wide = true;
+            method = select_exact_method(kf, true, opts.exact, reason);
+        }
+    }
 
-    std::vector<int> approx_vc_1_impl(Graph& g) {
-        
-        VCSolver s;
-        std::pair<bool, std::vector<int>> result = s.vc_approx_1(g);
+    stats_note("exact.method", "kernel + " + exact_method_name(method) + ": " + reason);
 
-    if(result.first)
-        return result.second;
-    else
-        return std::vector<int>{};
+    switch(method) {
+        case EXACT_FOREST:    cover = solver.vc_forest(reduced).second;    break;
+        case EXACT_BIPARTITE: cover = solver.vc_bipartite(reduced).second; break;
+        case EXACT_MASK:      cover = solver.vc_small(reduced).second;     break;
+        case EXACT_BNB:       cover = solver.vc_bnb(reduced, lifted).second; break;
+        case EXACT_SAT:       cover = cnf_sat_vc_sat(reduced, opts, lifted); break;
+        case EXACT_FPT:       cover = cnf_sat_vc_fpt(reduced, lifted);       break;
+        default:              break;
+    }
+
+    return kernel.lift(cover);
 }
 
-void * approx_vc_1_thread (void *arg) {
+void * run_vc_thread(struct thread_context *ctx, vc_impl impl, int algo) {
 
-    struct thread_context *ctx = (struct thread_context*)arg;
     std::pair<std::vector<int>, double> * output = new std::pair<std::vector<int>, double>{};
+    Progress progress(ALGO[algo - 1], ctx->mutex, ctx->opts.stream_mode && !ctx->opts.benchmark_mode);
     
     int d;
     pthread_cleanup_push(cleanup_vc_thread, output);
     pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &d);
-    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, &d);
-    
+    pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, &d);
+
     clockid_t cid;
     struct timespec t1, t2;
+    double cpu;
     pthread_getcpuclockid(pthread_self(), &cid);
     
     clock_gettime(cid, &t1);
-    output->first  = approx_vc_1_impl(ctx->g);
+    output->first  = solve_by_component(ctx->g, impl, ctx->opts, progress, cpu);
     clock_gettime(cid, &t2);
-    output->second = tdiff(t2, t1);
+    output->second = tdiff(t2, t1) + cpu;
 
+    // printing in finish_vc_thread() is a cancellation point
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &d);
     pthread_mutex_lock(ctx->mutex);
-    ctx->count += 1;
-    if(ctx->count == 3) {
-        pthread_cancel(ctx->thread[WATCHDOG]);
-    }
+    bool superseded = ctx->done[algo];
+    finish_vc_thread(ctx, algo, *output);
     pthread_mutex_unlock(ctx->mutex);
-    
+    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &d);
+
+    // an exact thread stopped by a proven cover has had its line printed
+    if(!superseded)
+        progress.finish(output->first);
+
     pthread_cleanup_pop(0);
     pthread_exit(output);
 }
 
-std::vector<int> approx_vc_2_impl(Graph& g) {
+void * cnf_sat_vc_thread (void *arg) {
+
+    return run_vc_thread((struct thread_context *)arg, cnf_sat_vc_impl, CNF_SAT_VC);
+}
+
+std::vector<int> approx_vc_1_impl(Graph& g, const struct options& opts, const vc_progress& progress) {
+    
+    VCSolver s;
+    std::pair<bool, std::vector<int>> result = s.vc_approx_1(g);
+
+    if(result.first)
+        return result.second;
+    else
+        return std::vector<int>{};
+}
+
+void * approx_vc_1_thread (void *arg) {
+
+    return run_vc_thread((struct thread_context *)arg, approx_vc_1_impl, APPROX_VC_1);
+}
+
+std::vector<int> approx_vc_2_impl(Graph& g, const struct options& opts, const vc_progress& progress) {
 
     VCSolver s;
     std::pair<bool, std::vector<int>> result = s.vc_approx_2(g);
@@ -343,32 +691,91 @@ std::vector<int> approx_vc_2_impl(Graph& g) {
 
 void * approx_vc_2_thread (void *arg) {
     
-    struct thread_context *ctx = (struct thread_context*)arg;
-    std::pair<std::vector<int>, double> * output = new std::pair<std::vector<int>, double>{};
+    return run_vc_thread((struct thread_context *)arg, approx_vc_2_impl, APPROX_VC_2);
+}
 
-    int d;
-    pthread_cleanup_push(cleanup_vc_thread, output);
-    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &d);
-    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, &d);
-    
-    clockid_t cid;
+// the redundant-vertex pass over a cover, timed on its own under STAT
+std::vector<int> prune_timed(Graph& g, const std::vector<int>& cover, const std::string& stat) {
+
+    VCSolver s;
     struct timespec t1, t2;
-    pthread_getcpuclockid(pthread_self(), &cid);
-    
-    clock_gettime(cid, &t1);
-    output->first = approx_vc_2_impl(ctx->g);
-    clock_gettime(cid, &t2);
-    output->second = tdiff(t2, t1);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t1);
+    std::vector<int> pruned = s.vc_prune(g, cover).second;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t2);
 
-    pthread_mutex_lock(ctx->mutex);
-    ctx->count += 1;
-    if(ctx->count == 3) {
-        pthread_cancel(ctx->thread[WATCHDOG]);
-    }
-    pthread_mutex_unlock(ctx->mutex);
+    stats_add(stat + "_time", tdiff(t2, t1));
+    stats_add(stat + "_removed", cover.size() - pruned.size());
+    return pruned;
+}
 
-    pthread_cleanup_pop(0);
-    pthread_exit(output);
+// the approximations followed by the redundant-vertex pass; the column
+// times them as a whole, the pass alone is in the stats
+std::vector<int> approx_vc_1_pruned_impl(Graph& g, const struct options& opts, const vc_progress& progress) {
+
+    VCSolver s;
+    std::pair<bool, std::vector<int>> result = s.vc_approx_1(g);
+
+    if(result.first)
+        return prune_timed(g, result.second, "prune.approx1");
+    else
+        return std::vector<int>{};
+}
+
+void * approx_vc_1_pruned_thread (void *arg) {
+
+    return run_vc_thread((struct thread_context *)arg, approx_vc_1_pruned_impl, APPROX_VC_1_PRUNED);
+}
+
+std::vector<int> approx_vc_2_pruned_impl(Graph& g, const struct options& opts, const vc_progress& progress) {
+
+    VCSolver s;
+    std::pair<bool, std::vector<int>> result = s.vc_approx_2(g);
+
+    if(result.first)
+        return prune_timed(g, result.second, "prune.approx2");
+    else
+        return std::vector<int>{};
+}
+
+void * approx_vc_2_pruned_thread (void *arg) {
+
+    return run_vc_thread((struct thread_context *)arg, approx_vc_2_pruned_impl, APPROX_VC_2_PRUNED);
+}
+
+std::vector<int> bnb_vc_impl(Graph& g, const struct options& opts, const vc_progress& progress) {
+
+    VCSolver s;
+    std::pair<bool, std::vector<int>> result = s.vc_bnb(g, progress);
+
+    if(result.first)
+        return result.second;
+    else
+        return std::vector<int>{};
+}
+
+void * bnb_vc_thread (void *arg) {
+
+    return run_vc_thread((struct thread_context *)arg, bnb_vc_impl, BNB_VC);
+}
+
+std::vector<int> ls_vc_impl(Graph& g, const struct options& opts, const vc_progress& progress) {
+
+    struct timespec now, deadline = opts.local_deadline;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double remaining = std::max(0.0, tdiff(deadline, now));
+
+    VCSolver s;
+    std::pair<bool, std::vector<int>> result = s.vc_local_search(g, remaining, progress);
+
+    if(result.first)
+        return result.second;
+    else
+        return std::vector<int>{};
+}
+
+void * ls_vc_thread (void *arg) {
+
+    return run_vc_thread((struct thread_context *)arg, ls_vc_impl, LS_VC);
 }
 
 void * watchdog_thread (void *arg) {
@@ -379,10 +786,10 @@ void * watchdog_thread (void *arg) {
     pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &d);
     pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, &d);
 
-    sleep(ctx->timeout);
+    sleep(ctx->opts.timeout_seconds);
 
     pthread_mutex_lock(ctx->mutex);
-    for(int i = 1; i < 4; i++) {
+    for(int i = 1; i <= NALGO; i++) {
 	pthread_cancel(ctx->thread[i]);
     }
     pthread_mutex_unlock(ctx->mutex);
@@ -0,0 +1,165 @@
+
+#include <pthread.h>
+
+#include <vector>
+#include <utility>
+
+#include "fpt.hpp"
+
+BoundedSearch::BoundedSearch(const Graph& g) {
+
+    this->n = g.vs();
+
+    int **m = g.adjmat();
+    this->nb.assign(this->n, Bitset(this->n));
+    for(int v1 = 0; v1 < this->n; v1++)
+        for(int v2 = 0; v2 < this->n; v2++)
+            if(m[v1][v2] == 1)
+                this->nb[v1].set(v2);
+}
+
+void BoundedSearch::take(int v, Bitset& alive, int& k) {
+
+    this->chosen.push_back(v);
+    alive.reset(v);
+    k--;
+}
+
+bool BoundedSearch::reduce(Bitset& alive, int& k) {
+
+    bool changed = true;
+    while(changed && k >= 0) {
+
+        changed = false;
+
+        Bitset snapshot = alive;
+        snapshot.for_each([&](int v) {
+
+            if(!alive.test(v) || k < 0)
+                return;
+
+            int d = this->degree(v, alive);
+            if(d == 0) {
+                alive.reset(v);
+            } else if(d == 1) {
+                this->take(this->nb[v].first_and(alive), alive, k);
+                changed = true;
+            } else if(d > k) {
+                // Buss: without v all d neighbors would be needed
+                this->take(v, alive, k);
+                changed = true;
+            } else if(d == 2) {
+                Bitset rest = alive;
+                rest &= this->nb[v];
+                int u = rest.first_and(alive);
+                rest.reset(u);
+                int w = rest.first_and(alive);
+
+                if(this->nb[u].test(w)) {
+                    this->take(u, alive, k);
+                    this->take(w, alive, k);
+                    changed = true;
+                }
+            }
+        });
+    }
+
+    return k >= 0;
+}
+
+void BoundedSearch::cover_cycles(Bitset& alive) {
+
+    // every vertex left has degree 2: take every other vertex of each cycle
+    int ignored = 0;
+    while(alive.any()) {
+
+        // visited vertices leave alive, so the walk only ever moves forward
+        int v = alive.first_and(alive);
+        for(int i = 0; ; i++) {
+
+            int u = this->nb[v].first_and(alive);
+
+            if(i % 2 == 0)
+                this->take(v, alive, ignored);
+            else
+                alive.reset(v);
+
+            if(u == -1)
+                break;
+
+            v = u;
+        }
+    }
+}
+
+bool BoundedSearch::search(Bitset alive, int k) {
+
+    pthread_testcancel();
+
+    size_t mark = this->chosen.size();
+
+    if(this->reduce(alive, k)) {
+
+        int v = -1, dmax = 0, edges = 0;
+        alive.for_each([&](int u) {
+            int d = this->degree(u, alive);
+            edges += d;
+            if(d > dmax) {
+                v = u;
+                dmax = d;
+            }
+        });
+        edges /= 2;
+
+        if(v == -1)
+            return true;
+
+        // k vertices of degree at most dmax cannot cover more edges than this
+        if(edges <= k * dmax) {
+
+            if(dmax <= 2) {
+                // cycles of length l need ceil(l / 2) vertices
+                size_t before = this->chosen.size();
+                this->cover_cycles(alive);
+                if((int)(this->chosen.size() - before) <= k)
+                    return true;
+            } else {
+
+                size_t branch = this->chosen.size();
+
+                Bitset with = alive;
+                int k1 = k;
+                this->take(v, with, k1);
+                if(this->search(with, k1))
+                    return true;
+                this->chosen.resize(branch);
+
+                Bitset without = alive;
+                int k2 = k;
+                without.reset(v);
+                Bitset neighbors = this->nb[v];
+                neighbors &= alive;
+                neighbors.for_each([&](int u) {
+                    this->take(u, without, k2);
+                });
+                if(k2 >= 0 && this->search(without, k2))
+                    return true;
+            }
+        }
+    }
+
+    this->chosen.resize(mark);
+    return false;
+}
+
+std::pair<bool, std::vector<int>> BoundedSearch::solve(int k) {
+
+    Bitset alive(this->n);
+    for(int v = 0; v < this->n; v++)
+        alive.set(v);
+
+    this->chosen.clear();
+    bool found = k >= 0 && this->search(alive, k);
+
+    return std::make_pair(found, found ? this->chosen : std::vector<int>{});
+}
@@ -0,0 +1,40 @@
+
+#ifndef _FPT_HPP
+#define _FPT_HPP
+
+#include <vector>
+#include <utility>
+
+#include "bitset.hpp"
+#include "graph.hpp"
+
+// Bounded search tree for "does the graph have a vertex cover of at most k
+// vertices?". Each branch on a vertex v of degree d >= 3 either takes v or
+// all of N(v), so the tree has O(1.47^k) leaves whatever the graph size;
+// pendants, triangles and vertices of degree above the budget are settled
+// without branching and leftover cycles are covered directly.
+class BoundedSearch {
+
+    private:
+
+        int n;
+        std::vector<Bitset> nb;
+        std::vector<int> chosen;
+
+        int degree(int v, const Bitset& alive) const {
+            return this->nb[v].count_and(alive);
+        }
+
+        void take(int v, Bitset& alive, int& k);
+        bool reduce(Bitset& alive, int& k);
+        void cover_cycles(Bitset& alive);
+        bool search(Bitset alive, int k);
+
+    public:
+
+        BoundedSearch(const Graph& g);
+
+        std::pair<bool, std::vector<int>> solve(int k);
+};
+
+#endif
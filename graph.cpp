@@ -26,6 +26,10 @@ Graph::Graph(const Graph& g): Graph(g.vertices.size()) {
     for(size_t x = 0; x < g.vertices.size(); x++)
         for(size_t y = 0; y < g.vertices.size(); y++)
             this->m[x][y] = g.m[x][y];
+
+    this->init_complete = g.init_complete;
+    this->index = g.index;
+    this->side = g.side;
 }
 
 Graph::~Graph() {
@@ -46,6 +50,8 @@ Graph& Graph::operator=(const Graph& g) {
         for(size_t y = 0; y < g.vertices.size(); y++)
             this->m[x][y] = g.m[x][y];
 
+    this->index = g.index;
+    this->side = g.side;
     return *this;
 }
 
@@ -69,6 +75,8 @@ void Graph::set_vertices(int vertices) {
         for(int y = 0; y < vertices; y++)
             m[x][y] = 0;
 
+    this->index.reset();
+    this->side.clear();
     this->init_complete = false;
 }
 
@@ -85,14 +93,101 @@ void Graph::set_edges(std::vector<std::pair<int, int>>& edges) {
         }
     }
     
+    this->index.reset();
+    this->color_sides();
     this->init_complete = true;
 }
 
+void Graph::color_sides() {
+
+    // BFS 2-coloring; an edge inside one color class means an odd cycle
+    this->side.assign(this->vertices.size(), -1);
+    for(size_t root = 0; root < this->vertices.size(); root++) {
+        if(this->side[root] != -1)
+            continue;
+
+        std::queue<int> q;
+        this->side[root] = 0;
+        q.push(root);
+
+        while(q.size() > 0) {
+
+            int u = q.front();
+            q.pop();
+
+            for(size_t v = 0; v < this->vertices.size(); v++) {
+                if(this->m[u][v] != 1)
+                    continue;
+
+                if(this->side[v] == this->side[u]) {
+                    this->side.clear();
+                    return;
+                }
+
+                if(this->side[v] == -1) {
+                    this->side[v] = 1 - this->side[u];
+                    q.push(v);
+                }
+            }
+        }
+    }
+}
+
 std::vector<int> Graph::get_vertices() {
     
     return this->vertices;
 }
 
+std::vector<std::vector<int>> Graph::get_components() const {
+
+    std::vector<std::vector<int>> components;
+    std::vector<bool> seen(this->vertices.size(), false);
+
+    for(size_t root = 0; root < this->vertices.size(); root++) {
+        if(seen[root])
+            continue;
+
+        std::vector<int> component;
+        std::queue<int> q;
+        seen[root] = true;
+        q.push(root);
+
+        while(q.size() > 0) {
+
+            int u = q.front();
+            q.pop();
+            component.push_back(u);
+
+            for(size_t v = 0; v < this->vertices.size(); v++) {
+                if(this->m[u][v] != 1 || seen[v])
+                    continue;
+
+                seen[v] = true;
+                q.push(v);
+            }
+        }
+
+        std::sort(component.begin(), component.end());
+        components.push_back(component);
+    }
+
+    return components;
+}
+
+Graph Graph::induced_subgraph(const std::vector<int>& vertices) const {
+
+    // vertex i of the subgraph is vertices[i] of this graph
+    Graph g(vertices.size());
+    std::vector<std::pair<int, int>> edges;
+    for(size_t x = 0; x < vertices.size(); x++)
+        for(size_t y = x + 1; y < vertices.size(); y++)
+            if(this->m[vertices[x]][vertices[y]] == 1)
+                edges.push_back(std::make_pair(x, y));
+
+    g.set_edges(edges);
+    return g;
+}
+
 std::vector<std::pair<int, int>> Graph::get_ranked_vertices() {
    
     std::vector<std::pair<int, int>> rvert = {};
@@ -133,10 +228,31 @@ void Graph::remove_edge(const std::pair<int, int>& edge) {
 
    this->m[edge.first][edge.second] = 0;
    this->m[edge.second][edge.first] = 0;
+   this->index.reset();
+}
+
+void Graph::build_index() {
+
+    this->index = std::make_shared<const PathIndex>(*this);
+}
+
+int Graph::get_distance(int v1, int v2) const {
+
+    if(this->index)
+        return this->index->distance(v1, v2);
+
+    std::vector<int> path = this->get_path(v1, v2);
+    if(v1 == v2)
+        return 0;
+
+    return path.empty() ? -1 : (int)path.size() - 1;
 }
 
 std::vector<int> Graph::get_path(int v1, int v2) const {
     
+    if(this->index)
+        return this->index->get_path(v1, v2);
+
     std::queue<int> q;
     int pi[this->vertices.size()];
 
@@ -4,6 +4,9 @@
 
 #include <vector>
 #include <utility>
+#include <memory>
+
+#include "pathindex.hpp"
 
 class Graph {
     
@@ -14,6 +17,13 @@ class Graph {
         
         bool init_complete;
         int **m;
+
+        std::shared_ptr<const PathIndex> index;
+
+        // 2-coloring found by set_edges, empty if the graph has an odd cycle
+        std::vector<int> side;
+
+        void color_sides();
         
     public:
         
@@ -29,6 +39,12 @@ class Graph {
         void remove_edge(const std::pair<int, int>& edge);
 
         std::vector<int> get_path(int v1, int v2) const;
+        int get_distance(int v1, int v2) const;
+
+        void build_index();
+        const PathIndex* path_index() const {
+            return this->index.get();
+        }
 
         bool initialized() const {
             return this->init_complete;
@@ -42,7 +58,20 @@ class Graph {
             return this->edges.size();
         }
 
+        // removing edges keeps a bipartite graph bipartite, so this stays
+        // correct after remove_edge, if conservative
+        bool is_bipartite() const {
+            return !this->side.empty() || this->vertices.empty();
+        }
+
+        // 0 or 1 for every vertex of a bipartite graph
+        int side_of(int v) const {
+            return this->side[v];
+        }
+
         std::vector<int> get_vertices();
+        std::vector<std::vector<int>> get_components() const;
+        Graph induced_subgraph(const std::vector<int>& vertices) const;
         std::vector<std::pair<int, int>> get_ranked_vertices();
         std::vector<std::pair<int, int>> get_edges();
 
@@ -0,0 +1,245 @@
+
+#include <pthread.h>
+#include <time.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+#include <utility>
+
+#include "kernel.hpp"
+#include "matching.hpp"
+
+Kernel::Kernel(const Graph& g, int upper_bound) {
+
+    this->n = g.vs();
+    this->budget = upper_bound;
+    this->lp_bound = 0;
+    this->match_seconds = 0;
+
+    int **m = g.adjmat();
+    this->adj.resize(this->n);
+    this->alive.resize(this->n, true);
+    for(int v1 = 0; v1 < this->n; v1++)
+        for(int v2 = 0; v2 < this->n; v2++)
+            if(m[v1][v2] == 1)
+                this->adj[v1].insert(v2);
+
+    this->reduce();
+
+    std::map<int, int> id;
+    for(size_t v = 0; v < this->adj.size(); v++) {
+        if(this->alive[v]) {
+            id[v] = this->kept.size();
+            this->kept.push_back(v);
+        }
+    }
+
+    std::vector<std::pair<int, int>> edges;
+    for(int v1: this->kept)
+        for(int v2: this->adj[v1])
+            if(v1 < v2)
+                edges.push_back(std::make_pair(id[v1], id[v2]));
+
+    this->reduced.set_vertices(this->kept.size());
+    this->reduced.set_edges(edges);
+}
+
+void Kernel::drop(int v) {
+
+    for(int u: this->adj[v])
+        this->adj[u].erase(v);
+
+    this->adj[v].clear();
+    this->alive[v] = false;
+}
+
+void Kernel::take(int v) {
+
+    this->forced.push_back(v);
+    this->drop(v);
+}
+
+void Kernel::fold_vertex(int v) {
+
+    // v has exactly two non-adjacent neighbors u and w: replace all three by
+    // a vertex x adjacent to N(u) + N(w). Either x is in the cover of the
+    // folded graph (and u, w are in the original one) or v is.
+    int u = *this->adj[v].begin();
+    int w = *this->adj[v].rbegin();
+    int x = this->adj.size();
+
+    std::set<int> neighbors;
+    for(int y: this->adj[u])
+        if(y != v)
+            neighbors.insert(y);
+    for(int y: this->adj[w])
+        if(y != v)
+            neighbors.insert(y);
+
+    this->drop(u);
+    this->drop(v);
+    this->drop(w);
+
+    this->adj.push_back(neighbors);
+    this->alive.push_back(true);
+    for(int y: neighbors)
+        this->adj[y].insert(x);
+
+    this->folds.push_back(fold{v, u, w, x});
+}
+
+bool Kernel::dominates(int v, int u) const {
+
+    // N[u] is a subset of N[v]: some minimum cover contains v
+    if(this->adj[u].size() > this->adj[v].size())
+        return false;
+
+    for(int y: this->adj[u])
+        if(y != v && this->adj[v].count(y) == 0)
+            return false;
+
+    return true;
+}
+
+bool Kernel::reduce_lp() {
+
+    // The half-integral LP optimum comes from a minimum cover C of the
+    // bipartite double cover (v on both sides, u-v' and v-u' per edge):
+    // x(v) = (|C & {v, v'}|) / 2. By Nemhauser-Trotter some minimum cover
+    // contains every vertex at 1 and none at 0.
+    std::vector<int> ids;
+    std::vector<int> index(this->adj.size(), -1);
+    for(size_t v = 0; v < this->adj.size(); v++) {
+        if(this->alive[v]) {
+            index[v] = ids.size();
+            ids.push_back(v);
+        }
+    }
+
+    std::vector<std::vector<int>> doubled(ids.size());
+    for(size_t i = 0; i < ids.size(); i++)
+        for(int y: this->adj[ids[i]])
+            doubled[i].push_back(index[y]);
+
+    struct timespec t1, t2;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t1);
+    BipartiteMatching matching(ids.size(), ids.size(), doubled);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t2);
+    this->match_seconds += (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec)/1E9;
+
+    // the LP value is |M| / 2
+    this->lp_bound = std::max(this->lp_bound, this->offset() + (matching.size() + 1) / 2);
+
+    std::vector<bool> left, right;
+    matching.min_vertex_cover(left, right);
+
+    bool changed = false;
+    for(size_t i = 0; i < ids.size(); i++) {
+        if(left[i] && right[i]) {
+            this->take(ids[i]);
+            changed = true;
+        }
+    }
+
+    for(size_t i = 0; i < ids.size(); i++) {
+        if(!left[i] && !right[i]) {
+            this->drop(ids[i]);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+void Kernel::reduce() {
+
+    bool changed = true;
+    while(changed) {
+
+        pthread_testcancel();
+        changed = false;
+
+        for(size_t v = 0; v < this->adj.size(); v++) {
+
+            if(!this->alive[v])
+                continue;
+
+            int degree = this->adj[v].size();
+            if(degree == 0) {
+                this->drop(v);
+            } else if(degree == 1) {
+                this->take(*this->adj[v].begin());
+            } else if(degree == 2) {
+                int u = *this->adj[v].begin();
+                int w = *this->adj[v].rbegin();
+
+                if(this->adj[u].count(w) == 1) {
+                    this->take(u);
+                    this->take(w);
+                } else {
+                    this->fold_vertex(v);
+                }
+            } else if(this->budget >= 0 && degree > this->budget - this->offset()) {
+                // a cover without v needs all of its neighbors, more than we can afford
+                this->take(v);
+            } else {
+                continue;
+            }
+
+            changed = true;
+        }
+
+        if(changed)
+            continue;
+
+        if(this->reduce_lp()) {
+            changed = true;
+            continue;
+        }
+
+        for(size_t v = 0; v < this->adj.size() && !changed; v++) {
+
+            if(!this->alive[v])
+                continue;
+
+            for(int u: this->adj[v]) {
+                if(this->dominates(v, u)) {
+                    this->take(v);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    this->lp_bound = std::max(this->lp_bound, this->offset());
+}
+
+std::vector<int> Kernel::lift(const std::vector<int>& cover) const {
+
+    std::set<int> in;
+    for(int v: cover)
+        in.insert(this->kept[v]);
+    for(int v: this->forced)
+        in.insert(v);
+
+    // undo the folds newest first, a fold vertex may itself have been folded
+    for(auto it = this->folds.rbegin(); it != this->folds.rend(); ++it) {
+        if(in.count(it->x) == 1) {
+            in.erase(it->x);
+            in.insert(it->u);
+            in.insert(it->w);
+        } else {
+            in.insert(it->v);
+        }
+    }
+
+    std::vector<int> lifted;
+    for(int v: in)
+        if(v < this->n)
+            lifted.push_back(v);
+
+    return lifted;
+}
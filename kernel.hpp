@@ -0,0 +1,76 @@
+
+#ifndef _KERNEL_HPP
+#define _KERNEL_HPP
+
+#include <set>
+#include <vector>
+
+#include "graph.hpp"
+
+// Shrinks a graph with the classic vertex cover reduction rules (isolated
+// vertices, pendants, degree-2 folding, dominance, Buss' high-degree rule and
+// the Nemhauser-Trotter LP reduction) until none of them applies. A minimum
+// cover of the reduced graph is lifted back to a minimum cover of the
+// original one.
+class Kernel {
+
+    private:
+
+        struct fold {
+            int v;
+            int u;
+            int w;
+            int x;
+        };
+
+        int n;
+        int budget;
+
+        // working graph; ids past n are vertices created by folding
+        std::vector<std::set<int>> adj;
+        std::vector<bool> alive;
+
+        std::vector<int> forced;
+        std::vector<fold> folds;
+
+        std::vector<int> kept;
+        Graph reduced;
+
+        int lp_bound;
+        double match_seconds;
+
+        void take(int v);
+        void drop(int v);
+        void fold_vertex(int v);
+        bool dominates(int v, int u) const;
+        bool reduce_lp();
+
+        void reduce();
+
+    public:
+
+        Kernel(const Graph& g, int upper_bound = -1);
+
+        Graph& graph() {
+            return this->reduced;
+        }
+
+        // number of cover vertices already decided by the reductions
+        int offset() const {
+            return this->forced.size() + this->folds.size();
+        }
+
+        std::vector<int> lift(const std::vector<int>& cover) const;
+
+        // the LP relaxation certifies that no cover of the original graph
+        // is smaller than this
+        int lower_bound() const {
+            return this->lp_bound;
+        }
+
+        double match_time() const {
+            return this->match_seconds;
+        }
+};
+
+#endif
@@ -0,0 +1,286 @@
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <vector>
+#include <utility>
+
+#include "localsearch.hpp"
+
+// candidates sampled for removal (FastVC's best from multiple selection)
+const int SAMPLES = 50;
+
+// NuMVC forgets edge weights once their mean exceeds GAMMA * |V|, keeping RHO of each
+const double GAMMA = 0.5;
+const double RHO = 0.3;
+
+LocalSearch::LocalSearch(Graph& g) {
+
+    this->n = g.vs();
+    this->edges = g.get_edges();
+    this->m = this->edges.size();
+
+    std::vector<int> degree(this->n, 0);
+    for(auto const& e: this->edges) {
+        degree[e.first]++;
+        degree[e.second]++;
+    }
+
+    this->start.assign(this->n + 1, 0);
+    for(int v = 0; v < this->n; v++)
+        this->start[v + 1] = this->start[v] + degree[v];
+
+    std::vector<int> fill(this->start.begin(), this->start.end() - 1);
+    this->neighbor.resize(2 * this->m);
+    this->edge_id.resize(2 * this->m);
+    for(int e = 0; e < this->m; e++) {
+        int a = this->edges[e].first, b = this->edges[e].second;
+        this->neighbor[fill[a]] = b;
+        this->edge_id[fill[a]++] = e;
+        this->neighbor[fill[b]] = a;
+        this->edge_id[fill[b]++] = e;
+    }
+
+    // with C empty every edge is uncovered and the dscore of v is its degree
+    this->weight.assign(this->m, 1);
+    this->total_weight = this->m;
+    this->dscore.assign(degree.begin(), degree.end());
+    this->in_cover.assign(this->n, false);
+    this->conf_change.assign(this->n, true);
+    this->age.assign(this->n, 0);
+    this->cover_pos.assign(this->n, -1);
+    this->uncovered_pos.assign(this->m, -1);
+    for(int e = 0; e < this->m; e++)
+        this->uncover(e);
+
+    this->step = 0;
+    this->seed = 0x9E3779B97F4A7C15ULL;
+
+    // the approx-2 cover: both endpoints of a maximal matching, whose size
+    // is also the lower bound
+    this->lower = 0;
+    for(auto const& e: this->edges) {
+        if(!this->in_cover[e.first] && !this->in_cover[e.second]) {
+            this->add(e.first);
+            this->add(e.second);
+            this->lower++;
+        }
+    }
+
+    // drop the vertices whose edges are all covered twice
+    std::vector<int> initial = this->cover;
+    for(int v: initial)
+        if(this->dscore[v] == 0)
+            this->remove(v);
+
+    this->best = this->cover;
+}
+
+uint64_t LocalSearch::next_random() {
+
+    // xorshift64*
+    this->seed ^= this->seed >> 12;
+    this->seed ^= this->seed << 25;
+    this->seed ^= this->seed >> 27;
+    return this->seed * 0x2545F4914F6CDD1DULL;
+}
+
+void LocalSearch::uncover(int e) {
+
+    this->uncovered_pos[e] = this->uncovered.size();
+    this->uncovered.push_back(e);
+}
+
+void LocalSearch::cover_edge(int e) {
+
+    int last = this->uncovered.back();
+    this->uncovered[this->uncovered_pos[e]] = last;
+    this->uncovered_pos[last] = this->uncovered_pos[e];
+    this->uncovered.pop_back();
+    this->uncovered_pos[e] = -1;
+}
+
+void LocalSearch::add(int v) {
+
+    this->in_cover[v] = true;
+    this->dscore[v] = -this->dscore[v];
+    this->cover_pos[v] = this->cover.size();
+    this->cover.push_back(v);
+
+    for(int i = this->start[v]; i < this->start[v + 1]; i++) {
+        int u = this->neighbor[i], e = this->edge_id[i];
+        if(this->in_cover[u]) {
+            // u no longer covers e on its own
+            this->dscore[u] += this->weight[e];
+        } else {
+            this->dscore[u] -= this->weight[e];
+            this->cover_edge(e);
+        }
+        this->conf_change[u] = true;
+    }
+}
+
+void LocalSearch::remove(int v) {
+
+    this->in_cover[v] = false;
+    this->dscore[v] = -this->dscore[v];
+
+    int last = this->cover.back();
+    this->cover[this->cover_pos[v]] = last;
+    this->cover_pos[last] = this->cover_pos[v];
+    this->cover.pop_back();
+    this->cover_pos[v] = -1;
+
+    for(int i = this->start[v]; i < this->start[v + 1]; i++) {
+        int u = this->neighbor[i], e = this->edge_id[i];
+        if(this->in_cover[u]) {
+            this->dscore[u] -= this->weight[e];
+        } else {
+            this->dscore[u] += this->weight[e];
+            this->uncover(e);
+        }
+        this->conf_change[u] = true;
+    }
+
+    this->conf_change[v] = false;
+}
+
+int LocalSearch::select_remove(int tabu) {
+
+    // highest dscore, the one longest unchanged on ties
+    int best = -1;
+    auto better = [&](int v) {
+        if(v == tabu)
+            return false;
+        if(best == -1)
+            return true;
+        if(this->dscore[v] != this->dscore[best])
+            return this->dscore[v] > this->dscore[best];
+        return this->age[v] < this->age[best];
+    };
+
+    int size = this->cover.size();
+    if(size <= SAMPLES) {
+        for(int v: this->cover)
+            if(better(v))
+                best = v;
+    } else {
+        for(int i = 0; i < SAMPLES; i++) {
+            int v = this->cover[this->next_random() % size];
+            if(better(v))
+                best = v;
+        }
+    }
+
+    return best == -1 ? tabu : best;
+}
+
+int LocalSearch::select_add(int e) const {
+
+    int a = this->edges[e].first, b = this->edges[e].second;
+
+    if(this->conf_change[a] != this->conf_change[b])
+        return this->conf_change[a] ? a : b;
+
+    if(this->dscore[a] != this->dscore[b])
+        return this->dscore[a] > this->dscore[b] ? a : b;
+
+    return this->age[a] <= this->age[b] ? a : b;
+}
+
+void LocalSearch::bump_weights() {
+
+    for(int e: this->uncovered) {
+        this->weight[e]++;
+        this->dscore[this->edges[e].first]++;
+        this->dscore[this->edges[e].second]++;
+    }
+    this->total_weight += this->uncovered.size();
+
+    if(this->total_weight >= GAMMA * this->n * (double)this->m)
+        this->forget_weights();
+}
+
+void LocalSearch::forget_weights() {
+
+    this->total_weight = 0;
+    for(int v = 0; v < this->n; v++)
+        this->dscore[v] = 0;
+
+    for(int e = 0; e < this->m; e++) {
+
+        this->weight[e] = std::max(1, (int)(RHO * this->weight[e]));
+        this->total_weight += this->weight[e];
+
+        int a = this->edges[e].first, b = this->edges[e].second;
+        if(this->in_cover[a] && !this->in_cover[b]) {
+            this->dscore[a] -= this->weight[e];
+        } else if(!this->in_cover[a] && this->in_cover[b]) {
+            this->dscore[b] -= this->weight[e];
+        } else if(!this->in_cover[a] && !this->in_cover[b]) {
+            this->dscore[a] += this->weight[e];
+            this->dscore[b] += this->weight[e];
+        }
+    }
+}
+
+std::vector<int> LocalSearch::solve(const struct timespec& deadline, long max_stall, const std::function<void(const std::vector<int>&, int)>& improved) {
+
+    long last_improved = this->step;
+    int added = -1;
+
+    if(improved)
+        improved(this->best, this->lower);
+
+    for(;;) {
+
+        if(this->uncovered.empty()) {
+
+            if(this->cover.size() < this->best.size()) {
+                last_improved = this->step;
+                this->best = this->cover;
+                if(improved)
+                    improved(this->best, this->lower);
+            }
+
+            if((int)this->best.size() <= this->lower || this->cover.empty())
+                break;
+
+            // look for a cover one smaller: drop the cheapest vertex of C
+            int v = this->cover[0];
+            for(int u: this->cover)
+                if(this->dscore[u] > this->dscore[v])
+                    v = u;
+            this->remove(v);
+            this->age[v] = this->step;
+            continue;
+        }
+
+        if(this->step % 1024 == 0) {
+            pthread_testcancel();
+
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if(now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec))
+                break;
+        }
+
+        if(this->step - last_improved > max_stall)
+            break;
+
+        // swap: one vertex out of C, one endpoint of an uncovered edge in
+        int u = this->select_remove(added);
+        this->remove(u);
+        this->age[u] = this->step;
+
+        int e = this->uncovered[this->next_random() % this->uncovered.size()];
+        added = this->select_add(e);
+        this->add(added);
+        this->age[added] = this->step;
+
+        this->bump_weights();
+        this->step++;
+    }
+
+    return this->best;
+}
@@ -0,0 +1,81 @@
+
+#ifndef _LOCALSEARCH_HPP
+#define _LOCALSEARCH_HPP
+
+#include <time.h>
+#include <stdint.h>
+
+#include <functional>
+#include <vector>
+
+#include "graph.hpp"
+
+// Anytime minimum vertex cover by local search in the style of NuMVC and
+// FastVC. Starting from the approx-2 cover it keeps a candidate C one vertex
+// smaller than the best cover found and repairs it with swap moves: remove
+// the best of a few sampled vertices of C, then add an endpoint of a random
+// uncovered edge. Uncovered edges gain weight every step so the search
+// leaves local minima, and configuration checking only lets a vertex back
+// into C once one of its neighbors changed since it was removed. The dscore
+// of every vertex (weight that becomes covered when it joins C, negated for
+// members of C) is maintained incrementally.
+class LocalSearch {
+
+    private:
+
+        int n;
+        int m;
+
+        // compressed adjacency: the neighbors of v and the ids of the edges
+        // to them are at start[v] ... start[v + 1] - 1
+        std::vector<int> start;
+        std::vector<int> neighbor;
+        std::vector<int> edge_id;
+        std::vector<std::pair<int, int>> edges;
+
+        std::vector<int> weight;
+        std::vector<long> dscore;
+        std::vector<bool> in_cover;
+        std::vector<bool> conf_change;
+        std::vector<long> age;
+
+        // members of C and uncovered edges, each with its position for O(1) removal
+        std::vector<int> cover;
+        std::vector<int> cover_pos;
+        std::vector<int> uncovered;
+        std::vector<int> uncovered_pos;
+
+        std::vector<int> best;
+        int lower;
+        long total_weight;
+        long step;
+
+        uint64_t seed;
+
+        uint64_t next_random();
+
+        void add(int v);
+        void remove(int v);
+        void uncover(int e);
+        void cover_edge(int e);
+
+        int select_remove(int tabu);
+        int select_add(int e) const;
+        void bump_weights();
+        void forget_weights();
+
+    public:
+
+        LocalSearch(Graph& g);
+
+        // Improves the cover until the deadline (CLOCK_MONOTONIC), until it
+        // meets the matching lower bound, or until max_stall steps bring no
+        // improvement. improved, if set, is called with every better cover.
+        std::vector<int> solve(const struct timespec& deadline, long max_stall, const std::function<void(const std::vector<int>&, int)>& improved = nullptr);
+
+        long steps() const {
+            return this->step;
+        }
+};
+
+#endif
@@ -0,0 +1,259 @@
+
+#ifndef _MASKSOLVER_HPP
+#define _MASKSOLVER_HPP
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "graph.hpp"
+
+// Set of at most 64 * W vertices held in W machine words.
+template<int W>
+struct VertexMask {
+
+    uint64_t w[W];
+
+    static VertexMask none() {
+        VertexMask m;
+        for(int i = 0; i < W; i++)
+            m.w[i] = 0;
+        return m;
+    }
+
+    void set(int v) {
+        this->w[v >> 6] |= (uint64_t)1 << (v & 63);
+    }
+
+    bool test(int v) const {
+        return (this->w[v >> 6] >> (v & 63)) & 1;
+    }
+
+    bool any() const {
+        for(int i = 0; i < W; i++)
+            if(this->w[i])
+                return true;
+        return false;
+    }
+
+    int count() const {
+        int c = 0;
+        for(int i = 0; i < W; i++)
+            c += __builtin_popcountll(this->w[i]);
+        return c;
+    }
+
+    // lowest member; the mask must not be empty
+    int first() const {
+        int i = 0;
+        while(!this->w[i])
+            i++;
+        return i * 64 + __builtin_ctzll(this->w[i]);
+    }
+
+    VertexMask operator&(const VertexMask& o) const {
+        VertexMask m;
+        for(int i = 0; i < W; i++)
+            m.w[i] = this->w[i] & o.w[i];
+        return m;
+    }
+
+    VertexMask operator|(const VertexMask& o) const {
+        VertexMask m;
+        for(int i = 0; i < W; i++)
+            m.w[i] = this->w[i] | o.w[i];
+        return m;
+    }
+
+    VertexMask operator-(const VertexMask& o) const {
+        VertexMask m;
+        for(int i = 0; i < W; i++)
+            m.w[i] = this->w[i] & ~o.w[i];
+        return m;
+    }
+};
+
+// Graphs of up to 64 vertices fit a single word, which is the common case.
+template<>
+struct VertexMask<1> {
+
+    uint64_t w;
+
+    static VertexMask none() {
+        VertexMask m;
+        m.w = 0;
+        return m;
+    }
+
+    void set(int v) {
+        this->w |= (uint64_t)1 << v;
+    }
+
+    bool test(int v) const {
+        return (this->w >> v) & 1;
+    }
+
+    bool any() const {
+        return this->w != 0;
+    }
+
+    int count() const {
+        return __builtin_popcountll(this->w);
+    }
+
+    int first() const {
+        return __builtin_ctzll(this->w);
+    }
+
+    VertexMask operator&(const VertexMask& o) const {
+        VertexMask m;
+        m.w = this->w & o.w;
+        return m;
+    }
+
+    VertexMask operator|(const VertexMask& o) const {
+        VertexMask m;
+        m.w = this->w | o.w;
+        return m;
+    }
+
+    VertexMask operator-(const VertexMask& o) const {
+        VertexMask m;
+        m.w = this->w & ~o.w;
+        return m;
+    }
+};
+
+// Exact minimum vertex cover for graphs of at most 64 * W vertices. The
+// graph is an array of neighbor masks and the search a plain recursion over
+// the mask of remaining vertices: pendant and isolated vertices are settled
+// without branching, nodes are pruned on a greedy matching bound, and the
+// branch is on a maximum degree vertex.
+template<int W>
+class MaskSolver {
+
+    private:
+
+        typedef VertexMask<W> Mask;
+
+        int n;
+        Mask nb[64 * W];
+
+        Mask best;
+        int best_size;
+
+        Mask single(int v) const {
+            Mask m = Mask::none();
+            m.set(v);
+            return m;
+        }
+
+        int matching_bound(Mask alive) const {
+            int matched = 0;
+            while(alive.any()) {
+                int v = alive.first();
+                Mask rest = this->nb[v] & alive;
+                alive = alive - this->single(v);
+                if(rest.any()) {
+                    alive = alive - this->single(rest.first());
+                    matched++;
+                }
+            }
+            return matched;
+        }
+
+        void search(Mask alive, Mask chosen, int size) {
+
+            pthread_testcancel();
+
+            int v = -1, dmax = 0;
+            bool changed = true;
+            while(changed) {
+
+                changed = false;
+                v = -1;
+                dmax = 0;
+
+                Mask scan = alive;
+                while(scan.any()) {
+                    int u = scan.first();
+                    scan = scan - this->single(u);
+                    if(!alive.test(u))
+                        continue;
+
+                    Mask rest = this->nb[u] & alive;
+                    int d = rest.count();
+                    if(d == 0) {
+                        alive = alive - this->single(u);
+                    } else if(d == 1) {
+                        int w = rest.first();
+                        chosen.set(w);
+                        alive = alive - this->single(w) - this->single(u);
+                        size++;
+                        changed = true;
+                    } else if(d > dmax) {
+                        v = u;
+                        dmax = d;
+                    }
+                }
+
+                if(size >= this->best_size)
+                    return;
+            }
+
+            if(v == -1) {
+                this->best = chosen;
+                this->best_size = size;
+                return;
+            }
+
+            if(size + this->matching_bound(alive) >= this->best_size)
+                return;
+
+            Mask without = alive - this->single(v);
+            this->search(without, chosen | this->single(v), size + 1);
+
+            Mask neighbors = this->nb[v] & alive;
+            this->search(without - neighbors, chosen | neighbors, size + dmax);
+        }
+
+    public:
+
+        MaskSolver(const Graph& g) {
+
+            this->n = g.vs();
+
+            int **m = g.adjmat();
+            for(int v1 = 0; v1 < this->n; v1++) {
+                this->nb[v1] = Mask::none();
+                for(int v2 = 0; v2 < this->n; v2++)
+                    if(m[v1][v2] == 1)
+                        this->nb[v1].set(v2);
+            }
+
+            // every vertex is a cover, improved on by the first leaf reached
+            this->best = Mask::none();
+            for(int v = 0; v < this->n; v++)
+                this->best.set(v);
+            this->best_size = this->n + 1;
+        }
+
+        std::vector<int> solve() {
+
+            Mask alive = Mask::none();
+            for(int v = 0; v < this->n; v++)
+                alive.set(v);
+
+            this->search(alive, Mask::none(), 0);
+
+            std::vector<int> cover;
+            for(int v = 0; v < this->n; v++)
+                if(this->best.test(v))
+                    cover.push_back(v);
+
+            return cover;
+        }
+};
+
+#endif
@@ -0,0 +1,113 @@
+
+#include <climits>
+#include <cstddef>
+#include <queue>
+#include <vector>
+#include <utility>
+
+#include "matching.hpp"
+
+BipartiteMatching::BipartiteMatching(int left, int right, std::vector<std::vector<int>> adj): adj(std::move(adj)) {
+
+    this->left_mate.assign(left, -1);
+    this->right_mate.assign(right, -1);
+    this->layer.assign(left, 0);
+    this->matched = 0;
+
+    // each phase augments along a maximal set of shortest vertex-disjoint
+    // augmenting paths
+    while(this->bfs()) {
+        for(int u = 0; u < left; u++)
+            if(this->left_mate[u] == -1 && this->dfs(u))
+                this->matched++;
+    }
+}
+
+bool BipartiteMatching::bfs() {
+
+    std::queue<int> q;
+    for(size_t u = 0; u < this->left_mate.size(); u++) {
+        if(this->left_mate[u] == -1) {
+            this->layer[u] = 0;
+            q.push(u);
+        } else {
+            this->layer[u] = INT_MAX;
+        }
+    }
+
+    bool found = false;
+    while(q.size() > 0) {
+
+        int u = q.front();
+        q.pop();
+
+        for(int v: this->adj[u]) {
+            int w = this->right_mate[v];
+            if(w == -1) {
+                found = true;
+            } else if(this->layer[w] == INT_MAX) {
+                this->layer[w] = this->layer[u] + 1;
+                q.push(w);
+            }
+        }
+    }
+
+    return found;
+}
+
+bool BipartiteMatching::dfs(int u) {
+
+    for(int v: this->adj[u]) {
+        int w = this->right_mate[v];
+        if(w == -1 || (this->layer[w] == this->layer[u] + 1 && this->dfs(w))) {
+            this->left_mate[u] = v;
+            this->right_mate[v] = u;
+            return true;
+        }
+    }
+
+    // dead end for this phase
+    this->layer[u] = INT_MAX;
+    return false;
+}
+
+void BipartiteMatching::min_vertex_cover(std::vector<bool>& left, std::vector<bool>& right) const {
+
+    // Z: vertices reachable from free left vertices by alternating paths;
+    // the cover is (L \ Z) + (R & Z)
+    std::vector<bool> zl(this->left_mate.size(), false);
+    std::vector<bool> zr(this->right_mate.size(), false);
+
+    std::queue<int> q;
+    for(size_t u = 0; u < this->left_mate.size(); u++) {
+        if(this->left_mate[u] == -1) {
+            zl[u] = true;
+            q.push(u);
+        }
+    }
+
+    while(q.size() > 0) {
+
+        int u = q.front();
+        q.pop();
+
+        for(int v: this->adj[u]) {
+            if(zr[v] || this->left_mate[u] == v)
+                continue;
+
+            zr[v] = true;
+            int w = this->right_mate[v];
+            if(w != -1 && !zl[w]) {
+                zl[w] = true;
+                q.push(w);
+            }
+        }
+    }
+
+    left.assign(this->left_mate.size(), false);
+    right.assign(this->right_mate.size(), false);
+    for(size_t u = 0; u < this->left_mate.size(); u++)
+        left[u] = !zl[u];
+    for(size_t v = 0; v < this->right_mate.size(); v++)
+        right[v] = zr[v];
+}
@@ -0,0 +1,45 @@
+
+#ifndef _MATCHING_HPP
+#define _MATCHING_HPP
+
+#include <vector>
+
+// Maximum matching of a bipartite graph via Hopcroft-Karp. Left vertices are
+// 0 .. left-1, right vertices 0 .. right-1 and adj[u] lists the right
+// neighbors of left vertex u.
+class BipartiteMatching {
+
+    private:
+
+        std::vector<std::vector<int>> adj;
+        std::vector<int> left_mate;
+        std::vector<int> right_mate;
+        std::vector<int> layer;
+        int matched;
+
+        bool bfs();
+        bool dfs(int u);
+
+    public:
+
+        BipartiteMatching(int left, int right, std::vector<std::vector<int>> adj);
+
+        int size() const {
+            return this->matched;
+        }
+
+        // -1 for unmatched vertices
+        int mate_of_left(int u) const {
+            return this->left_mate[u];
+        }
+
+        int mate_of_right(int v) const {
+            return this->right_mate[v];
+        }
+
+        // König's theorem: a minimum vertex cover with as many vertices as
+        // the matching has edges
+        void min_vertex_cover(std::vector<bool>& left, std::vector<bool>& right) const;
+};
+
+#endif
@@ -0,0 +1,157 @@
+
+#include <time.h>
+
+#include <algorithm>
+#include <climits>
+#include <queue>
+#include <vector>
+#include <utility>
+
+#include "graph.hpp"
+#include "pathindex.hpp"
+
+PathIndex::PathIndex(const Graph& g) {
+
+    struct timespec t1, t2;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    size_t N = (size_t)g.vs();
+    int **m = g.adjmat();
+
+    this->adj.resize(N);
+    for(size_t v1 = 0; v1 < N; v1++)
+        for(size_t v2 = 0; v2 < N; v2++)
+            if(m[v1][v2] == 1)
+                this->adj[v1].push_back(v2);
+
+    // hubs are visited by descending degree so that the early, unpruned
+    // searches run from the vertices that cover the most shortest paths
+    for(size_t v = 0; v < N; v++)
+        this->order.push_back(v);
+    std::stable_sort(this->order.begin(), this->order.end(), [this](int v1, int v2) { return this->adj[v1].size() > this->adj[v2].size(); });
+
+    this->labels.resize(N);
+    std::vector<int> dist(N, -1);
+    std::vector<int> root_label(N, INT_MAX);
+    std::vector<int> visited;
+
+    for(size_t r = 0; r < N; r++) {
+
+        int root = this->order[r];
+        for(auto const& l: this->labels[root])
+            root_label[l.first] = l.second;
+
+        std::queue<int> q;
+        dist[root] = 0;
+        visited.push_back(root);
+        q.push(root);
+
+        while(q.size() > 0) {
+
+            int u = q.front();
+            q.pop();
+
+            // prune if an earlier hub already certifies a path at least as short
+            bool covered = false;
+            for(auto const& l: this->labels[u]) {
+                if(root_label[l.first] != INT_MAX && root_label[l.first] + l.second <= dist[u]) {
+                    covered = true;
+                    break;
+                }
+            }
+
+            if(covered)
+                continue;
+
+            this->labels[u].push_back(std::make_pair((int)r, dist[u]));
+
+            for(int v: this->adj[u]) {
+                if(dist[v] != -1)
+                    continue;
+
+                dist[v] = dist[u] + 1;
+                visited.push_back(v);
+                q.push(v);
+            }
+        }
+
+        for(int v: visited)
+            dist[v] = -1;
+        visited.clear();
+
+        for(auto const& l: this->labels[root])
+            root_label[l.first] = INT_MAX;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    this->build_seconds = (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec)/1E9;
+}
+
+int PathIndex::distance(int v1, int v2) const {
+
+    // labels are sorted by hub rank, so a merge finds the common hubs
+    const std::vector<std::pair<int, int>>& l1 = this->labels[v1];
+    const std::vector<std::pair<int, int>>& l2 = this->labels[v2];
+
+    int best = INT_MAX;
+    size_t i = 0, j = 0;
+    while(i < l1.size() && j < l2.size()) {
+        if(l1[i].first == l2[j].first) {
+            best = std::min(best, l1[i].second + l2[j].second);
+            i++;
+            j++;
+        } else if(l1[i].first < l2[j].first) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+
+    return best == INT_MAX ? -1 : best;
+}
+
+std::vector<int> PathIndex::get_path(int v1, int v2) const {
+
+    std::vector<int> path;
+    int d = this->distance(v1, v2);
+    if(d <= 0)
+        return path;
+
+    // walk towards v2, always stepping to a neighbor one hop closer
+    int u = v1;
+    path.push_back(u);
+    while(u != v2) {
+        for(int v: this->adj[u]) {
+            if(this->distance(v, v2) == d - 1) {
+                u = v;
+                break;
+            }
+        }
+
+        d--;
+        path.push_back(u);
+    }
+
+    return path;
+}
+
+size_t PathIndex::label_entries() const {
+
+    size_t entries = 0;
+    for(auto const& l: this->labels)
+        entries += l.size();
+
+    return entries;
+}
+
+size_t PathIndex::memory_usage() const {
+
+    size_t bytes = sizeof(*this);
+    for(auto const& l: this->labels)
+        bytes += sizeof(l) + l.capacity() * sizeof(std::pair<int, int>);
+    for(auto const& a: this->adj)
+        bytes += sizeof(a) + a.capacity() * sizeof(int);
+    bytes += this->order.capacity() * sizeof(int);
+
+    return bytes;
+}
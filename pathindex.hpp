@@ -0,0 +1,39 @@
+
+#ifndef _PATHINDEX_HPP
+#define _PATHINDEX_HPP
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+class Graph;
+
+// Pruned landmark labeling over an unweighted graph. Every vertex keeps a
+// label of (hub, distance) pairs such that any shortest path between two
+// vertices passes through a hub shared by both labels.
+class PathIndex {
+
+    private:
+
+        std::vector<std::vector<int>> adj;
+        std::vector<std::vector<std::pair<int, int>>> labels;
+        std::vector<int> order;
+
+        double build_seconds;
+
+    public:
+
+        PathIndex(const Graph& g);
+
+        int distance(int v1, int v2) const;
+        std::vector<int> get_path(int v1, int v2) const;
+
+        size_t label_entries() const;
+        size_t memory_usage() const;
+
+        double build_time() const {
+            return this->build_seconds;
+        }
+};
+
+#endif
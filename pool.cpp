@@ -0,0 +1,108 @@
+
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "pool.hpp"
+
+struct pool_context {
+    // Context
+    std::vector<pthread_t>    workers;
+    size_t                     joined;
+    pthread_mutex_t             mutex;
+    std::atomic<size_t>          next;
+    // Input
+    size_t                          n;
+    const std::function<void(size_t)> *task;
+    // Output
+    double                        cpu;
+};
+
+// worker CPU of the pools this thread has started, theirs included
+static thread_local double pool_cpu = 0;
+
+double parallel_cpu() {
+    return pool_cpu;
+}
+
+static void * pool_worker_thread(void *arg) {
+
+    struct pool_context *ctx = (struct pool_context *)arg;
+
+    int d;
+    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &d);
+    pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, &d);
+
+    clockid_t cid;
+    struct timespec t1, t2;
+    pthread_getcpuclockid(pthread_self(), &cid);
+
+    clock_gettime(cid, &t1);
+    for(size_t i = ctx->next++; i < ctx->n; i = ctx->next++)
+        (*ctx->task)(i);
+    clock_gettime(cid, &t2);
+
+    pthread_mutex_lock(&ctx->mutex);
+    ctx->cpu += (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec)/1E9 + pool_cpu;
+    pthread_mutex_unlock(&ctx->mutex);
+
+    return NULL;
+}
+
+static void cleanup_pool(void *arg) {
+
+    struct pool_context *ctx = (struct pool_context *)arg;
+    for(size_t i = ctx->joined; i < ctx->workers.size(); i++)
+        pthread_cancel(ctx->workers[i]);
+    for(size_t i = ctx->joined; i < ctx->workers.size(); i++)
+        pthread_join(ctx->workers[i], NULL);
+    pthread_mutex_destroy(&ctx->mutex);
+}
+
+double parallel_for(size_t n, const std::function<void(size_t)>& task) {
+
+    // a single task is not worth a thread, run it on the caller
+    if(n <= 1) {
+        double before = pool_cpu;
+        if(n == 1)
+            task(0);
+        return pool_cpu - before;
+    }
+
+    struct pool_context ctx;
+    pthread_mutex_init(&ctx.mutex, NULL);
+    ctx.next = 0;
+    ctx.n = n;
+    ctx.task = &task;
+    ctx.cpu = 0;
+    ctx.joined = 0;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t nworkers = std::min(n, (size_t)std::max(cpus, 1L));
+
+    // the handler goes first: a worker must never outlive ctx, and it only
+    // waits for the workers that were created
+    pthread_cleanup_push(cleanup_pool, &ctx);
+    for(size_t i = 0; i < nworkers; i++) {
+        pthread_t worker;
+        if(pthread_create(&worker, NULL, pool_worker_thread, (void *)&ctx) != 0)
+            break;
+        ctx.workers.push_back(worker);
+    }
+
+    // no thread to be had: the caller does the work
+    if(ctx.workers.empty())
+        for(size_t i = ctx.next++; i < ctx.n; i = ctx.next++)
+            task(i);
+
+    for(; ctx.joined < ctx.workers.size(); ctx.joined++)
+        pthread_join(ctx.workers[ctx.joined], NULL);
+    pthread_cleanup_pop(1);
+
+    pool_cpu += ctx.cpu;
+    return ctx.cpu;
+}
@@ -0,0 +1,20 @@
+
+#ifndef _POOL_HPP
+#define _POOL_HPP
+
+#include <cstddef>
+#include <functional>
+
+// Runs task(0) ... task(n - 1) on up to one worker thread per online CPU and
+// blocks until all of them are done. Returns the CPU time, in seconds, spent
+// by the worker threads, since the caller's own thread clock does not see it.
+// That includes pools started by the tasks, also when a single task runs on
+// the caller. If the calling thread is cancelled while waiting, the workers
+// are cancelled with it.
+double parallel_for(size_t n, const std::function<void(size_t)>& task);
+
+// The CPU time, in seconds, of the workers of every parallel_for the calling
+// thread has run so far, for measuring a stretch of code that may start one.
+double parallel_cpu();
+
+#endif
@@ -0,0 +1,116 @@
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "portfolio.hpp"
+#include "pool.hpp"
+#include "stats.hpp"
+
+// the longest learnt clauses a portfolio shares
+const int SHARE_LENGTH = 8;
+
+ClauseExchange::ClauseExchange(size_t members, size_t capacity): capacity(capacity), read(members, std::vector<uint64_t>(members, 0)), nsent(0), nreceived(0) {
+
+    for(size_t i = 0; i < members; i++) {
+        std::unique_ptr<outbox> box(new outbox());
+        box->ring.reset(new std::atomic<int>[capacity]);
+        box->written = 0;
+        box->begun = 0;
+        this->outboxes.push_back(std::move(box));
+    }
+}
+
+void ClauseExchange::send(size_t member, const int *clause) {
+
+    size_t length = 0;
+    while(clause[length] != 0)
+        length++;
+    length++;
+
+    if(length > this->capacity)
+        return;
+
+    // readers that see a literal stored below also see begun moved past it
+    outbox& box = *this->outboxes[member];
+    uint64_t start = box.written.load(std::memory_order_relaxed);
+    box.begun.store(start + length, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for(size_t i = 0; i < length; i++)
+        box.ring[(start + i) % this->capacity].store(clause[i], std::memory_order_relaxed);
+    box.written.store(start + length, std::memory_order_release);
+
+    this->nsent++;
+}
+
+void ClauseExchange::receive(size_t member, std::vector<int>& clauses) {
+
+    for(size_t w = 0; w < this->outboxes.size(); w++) {
+        if(w == member)
+            continue;
+
+        outbox& box = *this->outboxes[w];
+        uint64_t& from = this->read[member][w];
+        uint64_t to = box.written.load(std::memory_order_acquire);
+
+        // a whole ring behind: where the clauses start is lost
+        if(to - from > this->capacity) {
+            from = to;
+            continue;
+        }
+
+        size_t size = clauses.size();
+        for(uint64_t p = from; p < to; p++)
+            clauses.push_back(box.ring[p % this->capacity].load(std::memory_order_relaxed));
+
+        // the writer may have come round and overwritten some of it
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(box.begun.load(std::memory_order_relaxed) - from > this->capacity) {
+            clauses.resize(size);
+        } else {
+            for(size_t i = size; i < clauses.size(); i++)
+                this->nreceived += clauses[i] == 0;
+        }
+
+        from = to;
+    }
+}
+
+int portfolio_solve(std::vector<std::unique_ptr<SatBackend>>& backends, int& status) {
+
+    ClauseExchange exchange(backends.size());
+    std::atomic<int> winner(-1);
+
+    for(size_t i = 0; i < backends.size(); i++) {
+        backends[i]->set_terminate([&winner]() {
+            return winner.load() >= 0;
+        });
+        backends[i]->set_learn(SHARE_LENGTH, [&exchange, i](const int *clause) {
+            exchange.send(i, clause);
+        });
+        backends[i]->set_import([&exchange, i](std::vector<int>& clauses) {
+            exchange.receive(i, clauses);
+        });
+    }
+
+    parallel_for(backends.size(), [&](size_t i) {
+        int answer = backends[i]->solve();
+        int none = -1;
+        if(answer != 0 && winner.compare_exchange_strong(none, (int)i))
+            status = answer;
+    });
+
+    // the callbacks point into this frame
+    for(size_t i = 0; i < backends.size(); i++) {
+        backends[i]->set_terminate(nullptr);
+        backends[i]->set_learn(0, nullptr);
+        backends[i]->set_import(nullptr);
+    }
+
+    stats_add("sat.shared", exchange.sent());
+    stats_add("sat.imported", exchange.received());
+
+    return winner;
+}
@@ -0,0 +1,64 @@
+
+#ifndef _PORTFOLIO_HPP
+#define _PORTFOLIO_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "satbackend.hpp"
+
+// Learnt clauses passed between the members of a portfolio without locks.
+// Every member writes DIMACS clauses, each ended by 0, to a ring of its own
+// and reads the rings of the others. A reader that falls a whole ring
+// behind, or sees its clauses overwritten while copying them, skips ahead:
+// sharing may lose clauses but never hands over a torn one.
+class ClauseExchange {
+
+    private:
+
+        struct outbox {
+            std::unique_ptr<std::atomic<int>[]> ring;
+            // literals written so far, and so far begun (seqlock style)
+            std::atomic<uint64_t> written;
+            std::atomic<uint64_t> begun;
+        };
+
+        size_t capacity;
+        std::vector<std::unique_ptr<outbox>> outboxes;
+
+        // read[r][w]: how far member r has read the ring of member w; only
+        // member r touches it
+        std::vector<std::vector<uint64_t>> read;
+
+        std::atomic<long> nsent;
+        std::atomic<long> nreceived;
+
+    public:
+
+        ClauseExchange(size_t members, size_t capacity = 1 << 16);
+
+        // by member, a clause ended by 0
+        void send(size_t member, const int *clause);
+
+        // appends to clauses what the other members sent since the last call
+        void receive(size_t member, std::vector<int>& clauses);
+
+        long sent() const {
+            return this->nsent;
+        }
+
+        long received() const {
+            return this->nreceived;
+        }
+};
+
+// Solves with every backend at once, each on a pool thread, sharing learnt
+// clauses through a ClauseExchange. The first backend to answer wins and
+// stops the others, which on fewer CPUs than backends may not even start.
+// Returns the index of the winner, or -1 if none answered, and its answer
+// (10 or 20) in status. The backends' own terminate is replaced.
+int portfolio_solve(std::vector<std::unique_ptr<SatBackend>>& backends, int& status);
+
+#endif
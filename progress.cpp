@@ -0,0 +1,106 @@
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "progress.hpp"
+
+Progress::Progress(const std::string& name, pthread_mutex_t *output, bool enabled) {
+
+    this->name = name;
+    this->enabled = enabled;
+    this->output = output;
+    pthread_mutex_init(&this->lock, NULL);
+
+    this->printed_upper = -1;
+    this->printed_lower = -1;
+}
+
+Progress::~Progress() {
+
+    pthread_mutex_destroy(&this->lock);
+}
+
+void Progress::set_components(const std::vector<std::vector<int>>& components) {
+
+    this->members = components;
+    this->covers.assign(components.size(), std::vector<int>{});
+    this->known.assign(components.size(), false);
+    this->lower.assign(components.size(), 0);
+}
+
+vc_progress Progress::component(size_t i) {
+
+    if(!this->enabled)
+        return vc_progress();
+
+    return [this, i](const std::vector<int>& cover, int lower) {
+        this->report(i, cover, lower);
+    };
+}
+
+void Progress::print_line(const std::string& prefix, std::vector<int> cover) {
+
+    std::sort(cover.begin(), cover.end());
+
+    pthread_mutex_lock(this->output);
+    std::cout << prefix << ": ";
+    for(size_t j = 0; j < cover.size(); j++)
+        std::cout << (j > 0 ? "," : "") << cover[j];
+    std::cout << std::endl;
+    pthread_mutex_unlock(this->output);
+}
+
+void Progress::report(size_t i, const std::vector<int>& cover, int lower) {
+
+    if(!this->enabled)
+        return;
+
+    // writing to stdout is a cancellation point, which must not be reached
+    // with either lock held
+    int state;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+    pthread_mutex_lock(&this->lock);
+
+    // an empty cover only moves the lower bound: components have edges
+    if(!cover.empty() && (!this->known[i] || cover.size() < this->covers[i].size())) {
+        this->covers[i].clear();
+        for(int v: cover)
+            this->covers[i].push_back(this->members[i][v]);
+        this->known[i] = true;
+    }
+    this->lower[i] = std::max(this->lower[i], lower);
+
+    int upper = 0, total_lower = 0;
+    bool complete = true;
+    std::vector<int> whole;
+    for(size_t c = 0; c < this->covers.size(); c++) {
+        complete = complete && this->known[c];
+        upper += this->covers[c].size();
+        total_lower += this->lower[c];
+        whole.insert(whole.end(), this->covers[c].begin(), this->covers[c].end());
+    }
+
+    if(complete && (this->printed_upper == -1 || upper < this->printed_upper || total_lower > this->printed_lower)) {
+        this->printed_upper = upper;
+        this->printed_lower = total_lower;
+        this->print_line(this->name + " (bounds " + std::to_string(total_lower) + ".." + std::to_string(upper) + ")", whole);
+    }
+
+    pthread_mutex_unlock(&this->lock);
+    pthread_setcancelstate(state, &state);
+}
+
+void Progress::finish(const std::vector<int>& cover) {
+
+    if(!this->enabled)
+        return;
+
+    int state;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+    this->print_line(this->name, cover);
+    pthread_setcancelstate(state, &state);
+}
@@ -0,0 +1,59 @@
+
+#ifndef _PROGRESS_HPP
+#define _PROGRESS_HPP
+
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+
+#include "cover.hpp"
+
+// Best cover and lower bound one algorithm has found so far for each
+// connected component of the graph. Solvers report improvements on a
+// component through the callback returned by component(); once every
+// component has a cover, each improvement of the whole-graph cover or its
+// lower bound is printed as
+//
+//     NAME (bounds LOWER..UPPER): v1,v2,...
+//
+// and finish() prints the final "NAME: v1,v2,..." line. Nothing is printed
+// unless streaming is enabled. Safe to call from the pool's worker threads.
+class Progress {
+
+    private:
+
+        std::string name;
+        bool enabled;
+
+        // serializes the lines of all algorithms on stdout
+        pthread_mutex_t *output;
+        pthread_mutex_t lock;
+
+        std::vector<std::vector<int>> members;
+        std::vector<std::vector<int>> covers;
+        std::vector<bool> known;
+        std::vector<int> lower;
+
+        int printed_upper;
+        int printed_lower;
+
+        void print_line(const std::string& prefix, std::vector<int> cover);
+
+    public:
+
+        Progress(const std::string& name, pthread_mutex_t *output, bool enabled);
+        ~Progress();
+
+        // vertices of every component in the graph's numbering
+        void set_components(const std::vector<std::vector<int>>& components);
+
+        // improvement callback for component i, in the component's numbering
+        vc_progress component(size_t i);
+
+        void report(size_t i, const std::vector<int>& cover, int lower);
+
+        void finish(const std::vector<int>& cover);
+};
+
+#endif
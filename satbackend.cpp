@@ -0,0 +1,298 @@
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "satbackend.hpp"
+#include "stats.hpp"
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+
+// One round of bounded conflicts. SimpSolver simplifies in the first round
+// of every solve and keeps eliminated variables eliminated after it.
+static Minisat::lbool solve_round(Minisat::Solver& solver, const Minisat::vec<Minisat::Lit>& assumptions, bool first) {
+    return solver.solveLimited(assumptions);
+}
+
+static Minisat::lbool solve_round(Minisat::SimpSolver& solver, const Minisat::vec<Minisat::Lit>& assumptions, bool first) {
+    return solver.solveLimited(assumptions, first, false);
+}
+
+static void freeze_var(Minisat::Solver& solver, Minisat::Var v) {
+}
+
+static void freeze_var(Minisat::SimpSolver& solver, Minisat::Var v) {
+    solver.setFrozen(v, true);
+}
+
+static bool eliminated(Minisat::Solver& solver, Minisat::Var v) {
+    return false;
+}
+
+static bool eliminated(Minisat::SimpSolver& solver, Minisat::Var v) {
+    return solver.isEliminated(v);
+}
+
+static void eliminate(Minisat::Solver& solver) {
+}
+
+// Bounded variable elimination and subsumption. Elimination stays on, so
+// solve() simplifies again with whatever clauses were added since.
+static void eliminate(Minisat::SimpSolver& solver) {
+
+    struct timespec t1, t2;
+    int vars = solver.eliminated_vars;
+    int clauses = solver.nClauses();
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t1);
+    solver.eliminate(false);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t2);
+
+    stats_add("simp.eliminated_vars", solver.eliminated_vars - vars);
+    stats_add("simp.removed_clauses", clauses - solver.nClauses());
+    stats_add("simp.time", (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9);
+}
+
+// MiniSat's Solver or SimpSolver. MiniSat has no cancellation points, so
+// solve() runs in rounds of bounded conflicts and checks for cancellation
+// and terminate in between. Learnt clauses carry over.
+template<class S>
+class MinisatBackend: public SatBackend {
+
+    private:
+
+        // polarity (true is the negative literal), activity, the learnt
+        // clauses and the trail are protected
+        class Solver: public S {
+            public:
+                void warm(Minisat::Var v, bool value, double activity) {
+                    this->polarity[v] = !value;
+                    this->varBumpActivity(v, activity);
+                }
+
+                // the units at level 0 and the learnt clauses of at most
+                // max_length literals, in DIMACS, each clause ended by 0
+                void learnt(int max_length, std::vector<int>& clauses) {
+                    int units = this->decisionLevel() == 0 ? this->trail.size() : this->trail_lim[0];
+                    for(int i = 0; i < units; i++) {
+                        clauses.push_back(dimacs(this->trail[i]));
+                        clauses.push_back(0);
+                    }
+                    for(int i = 0; i < this->learnts.size(); i++) {
+                        const Minisat::Clause& c = this->ca[this->learnts[i]];
+                        if(c.size() > max_length)
+                            continue;
+                        for(int j = 0; j < c.size(); j++)
+                            clauses.push_back(dimacs(c[j]));
+                        clauses.push_back(0);
+                    }
+                }
+        };
+
+        static int dimacs(Minisat::Lit l) {
+            return Minisat::sign(l) ? -(Minisat::var(l) + 1) : Minisat::var(l) + 1;
+        }
+
+        std::string name;
+        Solver solver;
+        Minisat::vec<Minisat::Lit> clause;
+        Minisat::vec<Minisat::Lit> assumptions;
+        std::vector<bool> refuted;
+        std::function<bool()> terminate;
+
+        // clause sharing: hashes of the clauses learnt or imported so far,
+        // so that none goes out twice
+        int max_length;
+        std::function<void(const int *)> learn;
+        std::function<void(std::vector<int>&)> import;
+        std::unordered_set<uint64_t> shared;
+        std::vector<int> buffer;
+
+        Minisat::Lit lit(int l) {
+            Minisat::Var v = abs(l) - 1;
+            while(this->solver.nVars() <= v)
+                this->solver.newVar();
+            return Minisat::mkLit(v, l < 0);
+        }
+
+        // false if the clause was shared before; sorts it
+        bool first_share(int *begin, int *end) {
+            std::sort(begin, end);
+            uint64_t hash = 14695981039346656037ULL;
+            for(int *l = begin; l != end; l++)
+                hash = (hash ^ (uint32_t)*l) * 1099511628211ULL;
+            return this->shared.insert(hash).second;
+        }
+
+        // Between rounds, at level 0: new short learnt clauses go out and
+        // imported clauses come in, except those over variables that
+        // preprocessing eliminated here.
+        void share() {
+            if(this->learn) {
+                this->buffer.clear();
+                this->solver.learnt(this->max_length, this->buffer);
+                for(size_t begin = 0, end = 0; end < this->buffer.size(); begin = ++end) {
+                    while(this->buffer[end] != 0)
+                        end++;
+                    if(this->first_share(&this->buffer[begin], &this->buffer[end]))
+                        this->learn(&this->buffer[begin]);
+                }
+            }
+
+            if(this->import) {
+                this->buffer.clear();
+                this->import(this->buffer);
+                for(size_t begin = 0, end = 0; end < this->buffer.size(); begin = ++end) {
+                    bool usable = true;
+                    for(; this->buffer[end] != 0; end++) {
+                        Minisat::Var v = abs(this->buffer[end]) - 1;
+                        if(v < this->solver.nVars() && eliminated(this->solver, v))
+                            usable = false;
+                    }
+                    if(!usable || !this->first_share(&this->buffer[begin], &this->buffer[end]))
+                        continue;
+                    for(size_t i = begin; i <= end; i++)
+                        this->add(this->buffer[i]);
+                }
+            }
+        }
+
+    public:
+
+        MinisatBackend(const std::string& name): name(name), max_length(0) {}
+
+        std::string signature() const {
+            return this->name;
+        }
+
+        void add(int l) {
+            if(l != 0) {
+                this->clause.push(this->lit(l));
+                return;
+            }
+            this->solver.addClause(this->clause);
+            this->clause.clear();
+        }
+
+        void assume(int l) {
+            this->assumptions.push(this->lit(l));
+        }
+
+        int solve() {
+            Minisat::lbool status;
+            bool first = true;
+            do {
+                pthread_testcancel();
+                if(this->terminate && this->terminate()) {
+                    status = l_Undef;
+                    break;
+                }
+
+                this->share();
+                this->solver.setConfBudget(10000);
+                status = solve_round(this->solver, this->assumptions, first);
+                first = false;
+            } while(status == l_Undef);
+
+            // the conflict holds the negations of the assumptions it used
+            this->refuted.assign(this->solver.nVars(), false);
+            if(status == l_False)
+                for(int i = 0; i < this->solver.conflict.size(); i++)
+                    this->refuted[Minisat::var(this->solver.conflict[i])] = true;
+
+            this->assumptions.clear();
+            return status == l_True ? 10 : status == l_False ? 20 : 0;
+        }
+
+        int val(int l) {
+            Minisat::Var v = abs(l) - 1;
+            if(v >= this->solver.model.size())
+                return -l;
+            bool value = (this->solver.model[v] == l_True) == (l > 0);
+            return value ? l : -l;
+        }
+
+        bool failed(int l) {
+            Minisat::Var v = abs(l) - 1;
+            return v < (int)this->refuted.size() && this->refuted[v];
+        }
+
+        void set_terminate(const std::function<bool()>& terminate) {
+            this->terminate = terminate;
+        }
+
+        void set_learn(int max_length, const std::function<void(const int *clause)>& learn) {
+            this->max_length = max_length;
+            this->learn = learn;
+        }
+
+        void set_import(const std::function<void(std::vector<int>&)>& import) {
+            this->import = import;
+        }
+
+        // A different random stream and initial order, and some random
+        // decisions, for every member; geometric restarts instead of Luby
+        // for odd members and random polarities for every third.
+        void diversify(int seed) {
+            if(seed == 0)
+                return;
+            this->solver.random_seed = 91648253 + 1000003.0 * seed;
+            this->solver.rnd_init_act = true;
+            this->solver.random_var_freq = std::min(0.005 * seed, 0.05);
+            this->solver.luby_restart = seed % 2 == 0;
+            this->solver.rnd_pol = seed % 3 == 2;
+        }
+
+        void warm(int v, bool value, double activity) {
+            this->lit(v);
+            this->solver.warm(v - 1, value, activity);
+        }
+
+        void freeze(int v) {
+            this->lit(v);
+            freeze_var(this->solver, v - 1);
+        }
+
+        void preprocess() {
+            eliminate(this->solver);
+        }
+
+        long conflicts() const {
+            return this->solver.conflicts;
+        }
+};
+
+std::unique_ptr<SatBackend> make_sat_backend(sat_backend kind) {
+
+    switch(kind) {
+        case SAT_MINISAT_SIMP:  return std::unique_ptr<SatBackend>(new MinisatBackend<Minisat::SimpSolver>("minisat-simp"));
+        default:                return std::unique_ptr<SatBackend>(new MinisatBackend<Minisat::Solver>("minisat"));
+    }
+}
+
+std::string sat_backend_name(sat_backend kind) {
+
+    switch(kind) {
+        case SAT_MINISAT:       return "minisat";
+        case SAT_MINISAT_SIMP:  return "simp";
+    }
+    return "unknown";
+}
+
+bool parse_sat_backend(const std::string& name, sat_backend& kind) {
+
+    for(sat_backend k: {SAT_MINISAT, SAT_MINISAT_SIMP}) {
+        if(sat_backend_name(k) == name) {
+            kind = k;
+            return true;
+        }
+    }
+    return false;
+}
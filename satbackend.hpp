@@ -0,0 +1,121 @@
+
+#ifndef _SATBACKEND_HPP
+#define _SATBACKEND_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cardinality.hpp"
+
+// An incremental SAT solver behind the calls of IPASIR. Literals are
+// nonzero ints, v or -v for variable v >= 1; variables exist once used.
+class SatBackend {
+
+    public:
+
+        virtual ~SatBackend() {}
+
+        virtual std::string signature() const = 0;
+
+        // adds lit to the clause being built, 0 ends the clause
+        virtual void add(int lit) = 0;
+
+        // holds for the next solve() only
+        virtual void assume(int lit) = 0;
+
+        // 10 satisfiable, 20 unsatisfiable, 0 stopped by terminate
+        virtual int solve() = 0;
+
+        // after 10: lit if lit is true in the model, -lit if false
+        virtual int val(int lit) = 0;
+
+        // after 20: whether the assumption lit was needed for the refutation
+        virtual bool failed(int lit) = 0;
+
+        // polled while solving; once it returns true solve() gives up with 0
+        virtual void set_terminate(const std::function<bool()>& terminate) = 0;
+
+        // learnt clauses of at most max_length literals go to learn, each
+        // ended by 0
+        virtual void set_learn(int max_length, const std::function<void(const int *clause)>& learn) = 0;
+
+        // Not in IPASIR: polled while solving for clauses that follow from
+        // the ones added, such as another solver's learnt clauses; import
+        // appends them to its argument, each ended by 0
+        virtual void set_import(const std::function<void(std::vector<int>&)>& import) {}
+
+        // Not in IPASIR: search differently from the other members of a
+        // portfolio as its seed-th member; 0 keeps the defaults. Goes before
+        // the first clause.
+        virtual void diversify(int seed) {}
+
+        // Not in IPASIR: try variable v with value first and raise its
+        // priority by activity. Backends without such controls ignore it.
+        virtual void warm(int v, bool value, double activity) {}
+
+        // Not in IPASIR: preprocessing keeps variable v, so models, later
+        // clauses and assumptions can use it
+        virtual void freeze(int v) {}
+
+        // Not in IPASIR: simplify the clauses added so far, if the backend
+        // preprocesses, and record what it removed in the stats
+        virtual void preprocess() {}
+
+        virtual long conflicts() const = 0;
+};
+
+enum sat_backend {
+    SAT_MINISAT,
+    SAT_MINISAT_SIMP
+};
+
+std::unique_ptr<SatBackend> make_sat_backend(sat_backend kind);
+
+std::string sat_backend_name(sat_backend kind);
+
+// "minisat" or "simp"; false if unknown
+bool parse_sat_backend(const std::string& name, sat_backend& kind);
+
+// Hands an encoding to one or more backends. The encoder's variable v is
+// the backend's v + 1, as in DimacsSink.
+class BackendSink: public CnfSink {
+
+    private:
+
+        std::vector<SatBackend*> backends;
+        int nvars;
+        int nclauses;
+
+    public:
+
+        BackendSink(SatBackend& backend): backends(1, &backend), nvars(0), nclauses(0) {}
+
+        BackendSink(const std::vector<SatBackend*>& backends): backends(backends), nvars(0), nclauses(0) {}
+
+        using CnfSink::add;
+
+        Minisat::Lit fresh() {
+            return Minisat::mkLit(this->nvars++);
+        }
+
+        void add(const Minisat::Lit *clause, size_t size) {
+            for(SatBackend *backend: this->backends) {
+                for(size_t i = 0; i < size; i++)
+                    backend->add(Minisat::sign(clause[i]) ? -(Minisat::var(clause[i]) + 1) : Minisat::var(clause[i]) + 1);
+                backend->add(0);
+            }
+            this->nclauses += 1;
+        }
+
+        int vars() const {
+            return this->nvars;
+        }
+
+        int clauses() const {
+            return this->nclauses;
+        }
+};
+
+#endif
@@ -0,0 +1,73 @@
+
+#include <pthread.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "stats.hpp"
+
+static pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+static std::map<std::string, double> stats;
+static std::map<std::string, std::string> notes;
+
+void stats_add(const std::string& key, double value) {
+
+    // a solver thread must not be cancelled while holding the lock
+    int state;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+
+    pthread_mutex_lock(&stats_mutex);
+    stats[key] += value;
+    pthread_mutex_unlock(&stats_mutex);
+
+    pthread_setcancelstate(state, &state);
+}
+
+void stats_max(const std::string& key, double value) {
+
+    int state;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+
+    pthread_mutex_lock(&stats_mutex);
+    auto it = stats.find(key);
+    if(it == stats.end() || it->second < value)
+        stats[key] = value;
+    pthread_mutex_unlock(&stats_mutex);
+
+    pthread_setcancelstate(state, &state);
+}
+
+void stats_note(const std::string& key, const std::string& text) {
+
+    int state;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+
+    pthread_mutex_lock(&stats_mutex);
+    std::string& note = notes[key];
+    if(note.empty())
+        note = text;
+    else if(("; " + note + "; ").find("; " + text + "; ") == std::string::npos)
+        note += "; " + text;
+    pthread_mutex_unlock(&stats_mutex);
+
+    pthread_setcancelstate(state, &state);
+}
+
+std::vector<std::pair<std::string, std::string>> stats_take() {
+
+    pthread_mutex_lock(&stats_mutex);
+    std::map<std::string, std::string> taken = notes;
+    for(auto const& s: stats) {
+        std::ostringstream value;
+        value << s.second;
+        taken[s.first] = value.str();
+    }
+    stats.clear();
+    notes.clear();
+    pthread_mutex_unlock(&stats_mutex);
+
+    return std::vector<std::pair<std::string, std::string>>(taken.begin(), taken.end());
+}
@@ -0,0 +1,25 @@
+
+#ifndef _STATS_HPP
+#define _STATS_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+
+// Named measurements gathered by the solvers while a graph is processed.
+// Values recorded under the same key are summed, so per-component figures
+// add up to the figure for the whole graph. Safe to call from any thread.
+void stats_add(const std::string& key, double value);
+
+// Keeps the largest value recorded under the key instead of the sum.
+void stats_max(const std::string& key, double value);
+
+// Free-form remark such as which method was picked and why. Distinct
+// remarks under the same key are joined with "; ".
+void stats_note(const std::string& key, const std::string& text);
+
+// Returns the measurements and remarks ordered by key, formatted for
+// printing, and starts over.
+std::vector<std::pair<std::string, std::string>> stats_take();
+
+#endif
@@ -3,8 +3,34 @@
  * https://github.com/onqtam/doctest/blob/master/doc/markdown/tutorial.md
  */
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// the signal handlers of this doctest need a constant SIGSTKSZ, which newer
+// glibc no longer has
+#define DOCTEST_CONFIG_NO_POSIX_SIGNALS
 #include "doctest.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "automorphism.hpp"
+#include "bnb.hpp"
+#include "cardinality.hpp"
+#include "cover.hpp"
+#include "cube.hpp"
+#include "dispatch.hpp"
+#include "fpt.hpp"
+#include "graph.hpp"
+#include "kernel.hpp"
+#include "localsearch.hpp"
+#include "portfolio.hpp"
+#include "satbackend.hpp"
+#include "treedp.hpp"
+#include "minisat/core/Solver.h"
+
 TEST_CASE("Successful Test Example") {
     int a = 5;
     CHECK(a == 5);
@@ -12,3 +38,935 @@ TEST_CASE("Successful Test Example") {
 TEST_CASE("Failing Test Examples") {
     CHECK(true == false);
 }
+
+// G(n, p) with a fixed generator, so failures can be replayed
+static Graph random_graph(int n, double p, unsigned& seed) {
+
+    std::vector<std::pair<int, int>> edges;
+    for(int v1 = 0; v1 < n; v1++)
+        for(int v2 = v1 + 1; v2 < n; v2++)
+            if(rand_r(&seed) < p * RAND_MAX)
+                edges.push_back(std::make_pair(v1, v2));
+
+    Graph g(n);
+    g.set_edges(edges);
+    return g;
+}
+
+TEST_CASE("PathIndex answers distances and paths like BFS") {
+    unsigned seed = 26;
+    for(int round = 0; round < 100; round++) {
+        int n = 1 + rand_r(&seed) % 40;
+        // sparse enough that some pairs are disconnected
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 600.0, seed);
+        INFO("round " << round << ", " << n << " vertices");
+
+        // without an index the graph answers by BFS
+        std::vector<std::vector<int>> bfs(n, std::vector<int>(n));
+        for(int v1 = 0; v1 < n; v1++)
+            for(int v2 = 0; v2 < n; v2++)
+                bfs[v1][v2] = g.get_distance(v1, v2);
+
+        g.build_index();
+        REQUIRE(g.path_index() != nullptr);
+        int **m = g.adjmat();
+        for(int v1 = 0; v1 < n; v1++) {
+            for(int v2 = 0; v2 < n; v2++) {
+                INFO("from " << v1 << " to " << v2);
+                CHECK(g.get_distance(v1, v2) == bfs[v1][v2]);
+
+                // a shortest path runs over edges from v1 to v2
+                std::vector<int> path = g.get_path(v1, v2);
+                if(bfs[v1][v2] > 0) {
+                    CHECK((int)path.size() == bfs[v1][v2] + 1);
+                    CHECK(path.front() == v1);
+                    CHECK(path.back() == v2);
+                    for(size_t i = 1; i < path.size(); i++)
+                        CHECK(m[path[i - 1]][path[i]] != 0);
+                }
+            }
+        }
+    }
+}
+
+static bool is_cover(Graph& g, const std::vector<int>& cover) {
+
+    std::vector<bool> in(g.vs(), false);
+    for(int v: cover) {
+        if(v < 0 || v >= g.vs())
+            return false;
+        in[v] = true;
+    }
+
+    for(const std::pair<int, int>& e: g.get_edges())
+        if(!in[e.first] && !in[e.second])
+            return false;
+    return true;
+}
+
+// a minimum cover, by trying every subset
+static std::vector<int> brute_force_cover(Graph& g) {
+
+    std::vector<std::pair<int, int>> edges = g.get_edges();
+    long best = (1L << g.vs()) - 1;
+    for(long set = 0; set < (1L << g.vs()); set++) {
+        if(__builtin_popcountl(set) >= __builtin_popcountl(best))
+            continue;
+
+        bool covered = true;
+        for(size_t i = 0; i < edges.size() && covered; i++)
+            covered = ((set >> edges[i].first) & 1) || ((set >> edges[i].second) & 1);
+        if(covered)
+            best = set;
+    }
+
+    std::vector<int> cover;
+    for(int v = 0; v < g.vs(); v++)
+        if((best >> v) & 1)
+            cover.push_back(v);
+    return cover;
+}
+
+TEST_CASE("Kernel lifts a minimum cover of the reduced graph to a minimum cover") {
+    unsigned seed = 28;
+    for(int round = 0; round < 300; round++) {
+        int n = 1 + rand_r(&seed) % 16;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 250.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices");
+
+        // Buss' rule needs a budget no smaller than the optimum
+        Kernel kernel(g, round % 2 ? opt + rand_r(&seed) % 3 : -1);
+        CHECK(kernel.lower_bound() <= opt);
+        CHECK(kernel.graph().vs() <= n);
+
+        std::vector<int> lifted = kernel.lift(brute_force_cover(kernel.graph()));
+        CHECK(is_cover(g, lifted));
+        CHECK((int)lifted.size() == opt);
+    }
+}
+
+TEST_CASE("Kernel reduces a tree to nothing") {
+    // a path and a star hang together: pendants alone settle them
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {2, 5}, {5, 6}, {5, 7}, {5, 8}};
+    Graph g(9);
+    g.set_edges(edges);
+
+    Kernel kernel(g);
+    CHECK(kernel.graph().vs() == 0);
+    std::vector<int> lifted = kernel.lift(std::vector<int>());
+    CHECK(is_cover(g, lifted));
+    CHECK(lifted.size() == 3);
+}
+
+TEST_CASE("BranchAndBound finds a minimum cover") {
+    unsigned seed = 30;
+    for(int round = 0; round < 300; round++) {
+        int n = 1 + rand_r(&seed) % 18;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices");
+
+        BranchAndBound bnb(g);
+        // every report is a valid cover, smaller than the last, above the bound
+        int last = n + 1;
+        std::vector<int> cover = bnb.solve([&](const std::vector<int>& better, int lower) {
+            CHECK(lower <= opt);
+            if(better.empty())
+                return;
+            CHECK(is_cover(g, better));
+            CHECK((int)better.size() <= last);
+            last = better.size();
+        });
+
+        CHECK(is_cover(g, cover));
+        CHECK((int)cover.size() == opt);
+    }
+}
+
+TEST_CASE("BranchAndBound keeps an optimal incumbent") {
+    unsigned seed = 31;
+    for(int round = 0; round < 100; round++) {
+        Graph g = random_graph(12, 0.3, seed);
+        std::vector<int> opt = brute_force_cover(g);
+
+        BranchAndBound bnb(g);
+        bnb.set_incumbent(opt);
+        std::vector<int> cover = bnb.solve();
+        CHECK(is_cover(g, cover));
+        CHECK(cover.size() == opt.size());
+    }
+}
+
+TEST_CASE("vc_small finds a minimum cover in one and two words") {
+    unsigned seed = 31;
+    VCSolver solver;
+    for(int round = 0; round < 200; round++) {
+        int n = 1 + rand_r(&seed) % 18;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices");
+
+        std::pair<bool, std::vector<int>> result = solver.vc_small(g);
+        CHECK(result.first);
+        CHECK(is_cover(g, result.second));
+        CHECK((int)result.second.size() == opt);
+    }
+
+    // past one word: two disjoint 40-cycles need 20 vertices each
+    std::vector<std::pair<int, int>> edges;
+    for(int v = 0; v < 80; v++)
+        edges.push_back(std::make_pair(v, v % 40 == 39 ? v - 39 : v + 1));
+    Graph cycles(80);
+    cycles.set_edges(edges);
+    std::pair<bool, std::vector<int>> result = solver.vc_small(cycles);
+    CHECK(result.first);
+    CHECK(is_cover(cycles, result.second));
+    CHECK(result.second.size() == 40);
+
+    CHECK(!solver.vc_small(Graph(129)).first);
+}
+
+TEST_CASE("BoundedSearch and vc_decide accept exactly the k of the optimum and above") {
+    unsigned seed = 32;
+    VCSolver solver;
+    for(int round = 0; round < 300; round++) {
+        int n = 1 + rand_r(&seed) % 16;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 150.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices, optimum " << opt);
+
+        for(int k = std::max(0, opt - 2); k <= opt + 1; k++) {
+            INFO("k = " << k);
+            BoundedSearch search(g);
+            std::pair<bool, std::vector<int>> plain = search.solve(k);
+            std::pair<bool, std::vector<int>> decided = solver.vc_decide(g, k);
+
+            CHECK(plain.first == (k >= opt));
+            CHECK(decided.first == (k >= opt));
+            if(plain.first) {
+                CHECK(is_cover(g, plain.second));
+                CHECK((int)plain.second.size() <= k);
+            }
+            if(decided.first) {
+                CHECK(is_cover(g, decided.second));
+                CHECK((int)decided.second.size() <= k);
+            }
+        }
+    }
+}
+
+TEST_CASE("vc_bipartite finds a minimum cover of a bipartite graph") {
+    unsigned seed = 33;
+    VCSolver solver;
+    for(int round = 0; round < 300; round++) {
+        // edges only between the two sides of a random split
+        int n = 1 + rand_r(&seed) % 18;
+        std::vector<int> side(n);
+        for(int v = 0; v < n; v++)
+            side[v] = rand_r(&seed) % 2;
+        double p = (rand_r(&seed) % 100) / 100.0;
+        std::vector<std::pair<int, int>> edges;
+        for(int v1 = 0; v1 < n; v1++)
+            for(int v2 = v1 + 1; v2 < n; v2++)
+                if(side[v1] != side[v2] && rand_r(&seed) < p * RAND_MAX)
+                    edges.push_back(std::make_pair(v1, v2));
+        Graph g(n);
+        g.set_edges(edges);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices");
+
+        std::pair<bool, std::vector<int>> result = solver.vc_bipartite(g);
+        CHECK(result.first);
+        CHECK(is_cover(g, result.second));
+        CHECK((int)result.second.size() == opt);
+    }
+
+    // a triangle is refused
+    std::vector<std::pair<int, int>> triangle = {{0, 1}, {1, 2}, {0, 2}};
+    Graph g(3);
+    g.set_edges(triangle);
+    CHECK(!solver.vc_bipartite(g).first);
+}
+
+TEST_CASE("vc_forest finds a minimum cover of a forest") {
+    unsigned seed = 34;
+    VCSolver solver;
+    for(int round = 0; round < 300; round++) {
+        // every vertex but a few roots hangs from an earlier one
+        int n = 1 + rand_r(&seed) % 18;
+        std::vector<std::pair<int, int>> edges;
+        for(int v = 1; v < n; v++)
+            if(rand_r(&seed) % 5 != 0)
+                edges.push_back(std::make_pair(rand_r(&seed) % v, v));
+        Graph g(n);
+        g.set_edges(edges);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices");
+
+        std::pair<bool, std::vector<int>> result = solver.vc_forest(g);
+        CHECK(result.first);
+        CHECK(is_cover(g, result.second));
+        CHECK((int)result.second.size() == opt);
+    }
+}
+
+TEST_CASE("TreewidthSolver finds a minimum cover within its width limit") {
+    unsigned seed = 35;
+    VCSolver solver;
+    for(int round = 0; round < 300; round++) {
+        int n = 1 + rand_r(&seed) % 16;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices");
+
+        // no decomposition of n vertices is wider than n - 1
+        std::pair<bool, std::vector<int>> result = solver.vc_treewidth(g, 16);
+        CHECK(result.first);
+        CHECK(is_cover(g, result.second));
+        CHECK((int)result.second.size() == opt);
+
+        // a narrower limit either holds the decomposition found or refuses
+        TreewidthSolver narrow(g, 3);
+        CHECK(narrow.width() <= 3);
+        if(narrow.width() != -1) {
+            std::vector<int> cover = narrow.solve();
+            CHECK(is_cover(g, cover));
+            CHECK((int)cover.size() == opt);
+        }
+    }
+
+    // K5 has treewidth 4
+    std::vector<std::pair<int, int>> edges;
+    for(int v1 = 0; v1 < 5; v1++)
+        for(int v2 = v1 + 1; v2 < 5; v2++)
+            edges.push_back(std::make_pair(v1, v2));
+    Graph k5(5);
+    k5.set_edges(edges);
+    CHECK(TreewidthSolver(k5, 3).width() == -1);
+    CHECK(TreewidthSolver(k5, 4).width() == 4);
+}
+
+static Graph cycle(int n) {
+
+    std::vector<std::pair<int, int>> edges;
+    for(int v = 0; v < n; v++)
+        edges.push_back(std::make_pair(v, (v + 1) % n));
+
+    Graph g(n);
+    g.set_edges(edges);
+    return g;
+}
+
+TEST_CASE("select_exact_method picks the special classes and then the kernel methods") {
+    std::string reason;
+
+    // a path is a forest, an even cycle is bipartite, an odd cycle is neither
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 2}, {2, 3}, {3, 4}};
+    Graph path(5);
+    path.set_edges(edges);
+    graph_features f = compute_features(path);
+    CHECK(f.forest);
+    CHECK(select_exact_method(f, false, "auto", reason) == EXACT_FOREST);
+
+    Graph even = cycle(6);
+    f = compute_features(even);
+    CHECK(!f.forest);
+    CHECK(f.bipartite);
+    CHECK(select_exact_method(f, false, "auto", reason) == EXACT_BIPARTITE);
+    CHECK(reason.find("forced") == std::string::npos);
+    // a forced method wins over the special classes
+    CHECK(select_exact_method(f, false, "sat", reason) == EXACT_KERNEL);
+    CHECK(select_exact_method(f, true, "sat", reason) == EXACT_SAT);
+    CHECK(reason == "forced");
+
+    Graph odd = cycle(7);
+    f = compute_features(odd);
+    CHECK(!f.bipartite);
+    CHECK(select_exact_method(f, false, "auto", reason) == EXACT_KERNEL);
+    CHECK(select_exact_method(f, true, "auto", reason) == EXACT_MASK);
+    CHECK(select_exact_method(compute_features(Graph(7)), false, "auto", reason) == EXACT_NONE);
+
+    // on larger kernels: the DP while sparse and narrow, then branch and
+    // bound, then SAT
+    f.vertices = 200;
+    f.edges = 300;
+    CHECK(select_exact_method(f, true, "auto", reason) == EXACT_TREEDP);
+    f.too_wide = true;
+    CHECK(select_exact_method(f, true, "auto", reason) == EXACT_BNB);
+    f.vertices = 400;
+    f.edges = 20000;
+    CHECK(select_exact_method(f, true, "auto", reason) == EXACT_SAT);
+    // a method that cannot solve the graph falls back to the features
+    CHECK(select_exact_method(f, true, "mask", reason) == EXACT_SAT);
+    CHECK(reason.find("does not apply") != std::string::npos);
+}
+
+TEST_CASE("LocalSearch returns a cover, minimum on small graphs") {
+    unsigned seed = 36;
+    for(int round = 0; round < 300; round++) {
+        int n = 1 + rand_r(&seed) % 18;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices, optimum " << opt);
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += 1;
+        LocalSearch search(g);
+        std::vector<int> cover = search.solve(deadline, 2000);
+
+        // every vertex at most once; a few thousand steps settle 18 vertices
+        std::set<int> distinct(cover.begin(), cover.end());
+        CHECK(distinct.size() == cover.size());
+        CHECK(is_cover(g, cover));
+        CHECK((int)cover.size() == opt);
+    }
+}
+
+TEST_CASE("vc_prune leaves a minimal cover inside the one it is given") {
+    unsigned seed = 37;
+    VCSolver solver;
+    for(int round = 0; round < 300; round++) {
+        int n = 1 + rand_r(&seed) % 30;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        INFO("round " << round << ", " << n << " vertices");
+
+        // a random vertex set, made a cover by adding an end of every
+        // uncovered edge
+        std::vector<bool> in(n, false);
+        for(int v = 0; v < n; v++)
+            in[v] = rand_r(&seed) % 2;
+        for(const std::pair<int, int>& e: g.get_edges())
+            if(!in[e.first] && !in[e.second])
+                in[rand_r(&seed) % 2 ? e.first : e.second] = true;
+        std::vector<int> cover;
+        for(int v = 0; v < n; v++)
+            if(in[v])
+                cover.push_back(v);
+
+        std::pair<bool, std::vector<int>> result = solver.vc_prune(g, cover);
+        CHECK(result.first);
+        std::vector<int>& pruned = result.second;
+        CHECK(is_cover(g, pruned));
+        for(int v: pruned)
+            CHECK(in[v]);
+
+        // no vertex left in can be dropped
+        for(size_t i = 0; i < pruned.size(); i++) {
+            std::vector<int> smaller = pruned;
+            smaller.erase(smaller.begin() + i);
+            CHECK(!is_cover(g, smaller));
+        }
+    }
+}
+
+static bool is_automorphism(Graph& g, const std::vector<int>& perm) {
+
+    std::vector<bool> seen(g.vs(), false);
+    for(int v: perm) {
+        if(v < 0 || v >= g.vs() || seen[v])
+            return false;
+        seen[v] = true;
+    }
+
+    int **m = g.adjmat();
+    for(const std::pair<int, int>& e: g.get_edges())
+        if(m[perm[e.first]][perm[e.second]] != 1)
+            return false;
+    return (int)perm.size() == g.vs();
+}
+
+// order of the group the generators span, by closing them under composition
+static size_t group_order(int n, const std::vector<std::vector<int>>& generators) {
+
+    std::vector<int> identity(n);
+    for(int v = 0; v < n; v++)
+        identity[v] = v;
+
+    std::set<std::vector<int>> group = {identity};
+    std::vector<std::vector<int>> open = {identity};
+    while(!open.empty()) {
+        std::vector<int> a = open.back();
+        open.pop_back();
+        for(const std::vector<int>& s: generators) {
+            std::vector<int> b(n);
+            for(int v = 0; v < n; v++)
+                b[v] = s[a[v]];
+            if(group.insert(b).second)
+                open.push_back(b);
+        }
+    }
+
+    return group.size();
+}
+
+TEST_CASE("Automorphisms generates the whole automorphism group") {
+    unsigned seed = 42;
+    for(int round = 0; round < 200; round++) {
+        int n = 1 + rand_r(&seed) % 7;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        INFO("round " << round << ", " << n << " vertices");
+
+        Automorphisms group(g);
+        for(const std::vector<int>& perm: group.generators())
+            CHECK(is_automorphism(g, perm));
+
+        // every permutation that is an automorphism must be reached
+        std::vector<int> perm(n);
+        for(int v = 0; v < n; v++)
+            perm[v] = v;
+        size_t order = 0;
+        do {
+            order += is_automorphism(g, perm);
+        } while(std::next_permutation(perm.begin(), perm.end()));
+        CHECK(group_order(n, group.generators()) == order);
+    }
+
+    // the Petersen graph has 120 automorphisms
+    std::vector<std::pair<int, int>> edges;
+    for(int v = 0; v < 5; v++) {
+        edges.push_back(std::make_pair(v, (v + 1) % 5));
+        edges.push_back(std::make_pair(v, v + 5));
+        edges.push_back(std::make_pair(v + 5, (v + 2) % 5 + 5));
+    }
+    Graph petersen(10);
+    petersen.set_edges(edges);
+    Automorphisms group(petersen);
+    CHECK(group_order(10, group.generators()) == 120);
+}
+
+TEST_CASE("vc_cnf_sat stays exact under lex-leader constraints") {
+    unsigned seed = 43;
+    for(int round = 0; round < 100; round++) {
+        int n = 2 + rand_r(&seed) % 8;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices, optimum " << opt);
+
+        cnf_options cnf;
+        cnf.automorphisms = Automorphisms(g).generators();
+        for(int positions = 0; positions < 2; positions++) {
+            cnf.break_positions = positions;
+            for(int k = std::max(0, opt - 1); k <= opt + 1; k++) {
+                VCSolver solver(cnf);
+                std::pair<bool, std::vector<int>> result = solver.vc_cnf_sat(g, k);
+                CHECK(result.first == (k >= opt));
+                if(result.first) {
+                    CHECK(is_cover(g, result.second));
+                }
+            }
+        }
+    }
+}
+
+// clauses straight into a MiniSat solver
+class SolverSink: public CnfSink {
+
+    public:
+
+        Minisat::Solver solver;
+
+        Minisat::Lit fresh() {
+            return Minisat::mkLit(this->solver.newVar());
+        }
+
+        void add(const Minisat::Lit *clause, size_t size) {
+            Minisat::vec<Minisat::Lit> c;
+            for(size_t i = 0; i < size; i++)
+                c.push(clause[i]);
+            this->solver.addClause(c);
+        }
+};
+
+TEST_CASE("Cardinality encoders allow exactly the assignments of at most k true literals") {
+    for(cardinality_encoding encoding: {CARD_SEQUENTIAL, CARD_TOTALIZER, CARD_SORTER, CARD_ADDER}) {
+        for(int n = 1; n <= 7; n++) {
+            for(int k = -1; k <= n + 1; k++) {
+                std::string name = cardinality_name(encoding);
+                INFO(name << ", at most " << k << " of " << n);
+
+                SolverSink sink;
+                std::vector<Minisat::Lit> lits(n);
+                for(Minisat::Lit& l: lits)
+                    l = sink.fresh();
+                make_cardinality_encoder(encoding)->at_most(sink, lits, k);
+
+                // every assignment of the literals, the auxiliaries left free
+                for(int set = 0; set < (1 << n); set++) {
+                    INFO("assignment " << set);
+                    Minisat::vec<Minisat::Lit> assumptions;
+                    for(int i = 0; i < n; i++)
+                        assumptions.push((set >> i) & 1 ? lits[i] : ~lits[i]);
+                    CHECK(sink.solver.solve(assumptions) == (__builtin_popcount(set) <= k));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("vc_cnf_sat is exact with every cardinality encoding") {
+    unsigned seed = 44;
+    for(int round = 0; round < 60; round++) {
+        int n = 2 + rand_r(&seed) % 8;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices, optimum " << opt);
+
+        for(cardinality_encoding encoding: {CARD_SEQUENTIAL, CARD_TOTALIZER, CARD_SORTER, CARD_ADDER}) {
+            cnf_options cnf;
+            cnf.cardinality = encoding;
+            for(int k = std::max(0, opt - 1); k <= opt + 1; k++) {
+                VCSolver solver(cnf);
+                std::pair<bool, std::vector<int>> result = solver.vc_cnf_sat(g, k);
+                CHECK(result.first == (k >= opt));
+                if(result.first) {
+                    CHECK(is_cover(g, result.second));
+                    CHECK((int)result.second.size() <= k);
+                }
+            }
+        }
+    }
+}
+
+// whether some assignment of n variables satisfies the clauses (DIMACS,
+// one vector each) and the assumptions
+static bool brute_force_sat(int n, const std::vector<std::vector<int>>& clauses, const std::vector<int>& assumptions) {
+
+    for(long set = 0; set < (1L << n); set++) {
+        auto value = [set](int l) {
+            bool x = (set >> (abs(l) - 1)) & 1;
+            return l > 0 ? x : !x;
+        };
+
+        bool satisfied = true;
+        for(int a: assumptions)
+            satisfied = satisfied && value(a);
+        for(size_t c = 0; c < clauses.size() && satisfied; c++) {
+            bool any = false;
+            for(int l: clauses[c])
+                any = any || value(l);
+            satisfied = any;
+        }
+        if(satisfied)
+            return true;
+    }
+
+    return false;
+}
+
+static std::vector<std::vector<int>> random_cnf(int n, int m, int length, unsigned& seed) {
+
+    std::vector<std::vector<int>> clauses(m);
+    for(std::vector<int>& c: clauses)
+        for(int i = 1 + rand_r(&seed) % length; i > 0; i--)
+            c.push_back((1 + rand_r(&seed) % n) * (rand_r(&seed) % 2 ? 1 : -1));
+    return clauses;
+}
+
+TEST_CASE("SAT backends answer like brute force, under assumptions and again") {
+    unsigned seed = 45;
+    for(int round = 0; round < 300; round++) {
+        int n = 3 + rand_r(&seed) % 6;
+        std::vector<std::vector<int>> clauses = random_cnf(n, rand_r(&seed) % 20, 3, seed);
+        std::vector<int> assumptions;
+        for(int i = rand_r(&seed) % 3; i > 0; i--)
+            assumptions.push_back((1 + rand_r(&seed) % n) * (rand_r(&seed) % 2 ? 1 : -1));
+        bool expected = brute_force_sat(n, clauses, assumptions);
+        INFO("round " << round);
+
+        for(sat_backend kind: {SAT_MINISAT, SAT_MINISAT_SIMP}) {
+            std::unique_ptr<SatBackend> backend = make_sat_backend(kind);
+            for(const std::vector<int>& c: clauses) {
+                for(int l: c)
+                    backend->add(l);
+                backend->add(0);
+            }
+            for(int a: assumptions)
+                backend->assume(a);
+
+            int answer = backend->solve();
+            CHECK(answer == (expected ? 10 : 20));
+            if(answer == 10) {
+                for(int a: assumptions)
+                    CHECK(backend->val(a) == a);
+                for(const std::vector<int>& c: clauses) {
+                    bool any = false;
+                    for(int l: c)
+                        any = any || backend->val(l) == l;
+                    CHECK(any);
+                }
+            }
+
+            // the assumptions are gone for the next call
+            CHECK(backend->solve() == (brute_force_sat(n, clauses, std::vector<int>()) ? 10 : 20));
+        }
+    }
+}
+
+TEST_CASE("SAT backends report failed assumptions and stop when told to") {
+    for(sat_backend kind: {SAT_MINISAT, SAT_MINISAT_SIMP}) {
+        std::unique_ptr<SatBackend> backend = make_sat_backend(kind);
+        backend->add(-1);
+        backend->add(0);
+        backend->add(2);
+        backend->add(3);
+        backend->add(0);
+        backend->assume(1);
+        backend->assume(2);
+        CHECK(backend->solve() == 20);
+        CHECK(backend->failed(1));
+
+        backend->set_terminate([]() { return true; });
+        CHECK(backend->solve() == 0);
+        backend->set_terminate(nullptr);
+        CHECK(backend->solve() == 10);
+    }
+}
+
+TEST_CASE("Preprocessing keeps frozen variables usable") {
+    unsigned seed = 46;
+    for(int round = 0; round < 200; round++) {
+        int n = 4 + rand_r(&seed) % 5;
+        std::vector<std::vector<int>> clauses = random_cnf(n, rand_r(&seed) % 16, 3, seed);
+        INFO("round " << round);
+
+        // variables 1 .. n / 2 are frozen, the rest may be eliminated
+        int frozen = n / 2;
+        for(sat_backend kind: {SAT_MINISAT, SAT_MINISAT_SIMP}) {
+            std::unique_ptr<SatBackend> backend = make_sat_backend(kind);
+            for(const std::vector<int>& c: clauses) {
+                for(int l: c)
+                    backend->add(l);
+                backend->add(0);
+            }
+            for(int v = 1; v <= frozen; v++)
+                backend->freeze(v);
+            backend->preprocess();
+
+            // a clause added afterwards over frozen variables
+            std::vector<std::vector<int>> more = clauses;
+            more.push_back(std::vector<int>{1, frozen == 1 ? -1 : -2});
+            for(int l: more.back())
+                backend->add(l);
+            backend->add(0);
+
+            for(int set = 0; set < (1 << frozen); set++) {
+                std::vector<int> assumptions;
+                for(int v = 1; v <= frozen; v++)
+                    assumptions.push_back((set >> (v - 1)) & 1 ? v : -v);
+                for(int a: assumptions)
+                    backend->assume(a);
+
+                int answer = backend->solve();
+                CHECK(answer == (brute_force_sat(n, more, assumptions) ? 10 : 20));
+                if(answer == 10) {
+                    for(int a: assumptions)
+                        CHECK(backend->val(a) == a);
+                    for(const std::vector<int>& c: more) {
+                        bool any = false;
+                        for(int l: c)
+                            any = any || backend->val(l) == l;
+                        CHECK(any);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("vc_cnf_sat is exact on the preprocessing backend") {
+    unsigned seed = 47;
+    for(int round = 0; round < 60; round++) {
+        int n = 2 + rand_r(&seed) % 8;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices, optimum " << opt);
+
+        for(cardinality_encoding encoding: {CARD_SLOTS, CARD_TOTALIZER}) {
+            cnf_options cnf;
+            cnf.backend = SAT_MINISAT_SIMP;
+            cnf.cardinality = encoding;
+            for(int k = std::max(0, opt - 1); k <= opt + 1; k++) {
+                VCSolver solver(cnf);
+                std::pair<bool, std::vector<int>> result = solver.vc_cnf_sat(g, k);
+                CHECK(result.first == (k >= opt));
+                if(result.first) {
+                    CHECK(is_cover(g, result.second));
+                    CHECK((int)result.second.size() <= k);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("ClauseExchange hands every member the others' clauses, whole") {
+    ClauseExchange exchange(3, 16);
+    const int a[] = {1, -2, 0};
+    const int b[] = {3, 0};
+    exchange.send(0, a);
+    exchange.send(1, b);
+
+    std::vector<int> got;
+    exchange.receive(2, got);
+    CHECK(got == std::vector<int>{1, -2, 0, 3, 0});
+
+    got.clear();
+    exchange.receive(0, got);
+    CHECK(got == std::vector<int>{3, 0});
+
+    // nothing new, and a member never gets its own clauses back
+    got.clear();
+    exchange.receive(2, got);
+    exchange.receive(1, got);
+    CHECK(got == std::vector<int>{1, -2, 0});
+    CHECK(exchange.sent() == 2);
+    CHECK(exchange.received() == 4);
+
+    // a reader lapped by a whole ring loses those clauses, never half of one
+    const int c[] = {4, 5, 6, 7, 0};
+    for(int i = 0; i < 5; i++)
+        exchange.send(0, c);
+    got.clear();
+    exchange.receive(1, got);
+    CHECK(got.empty());
+    exchange.send(0, c);
+    exchange.receive(1, got);
+    CHECK(got == std::vector<int>{4, 5, 6, 7, 0});
+
+    // longer than the ring: not sent at all
+    const int d[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 0};
+    exchange.send(0, d);
+    got.clear();
+    exchange.receive(1, got);
+    CHECK(got.empty());
+}
+
+TEST_CASE("Imported clauses over eliminated variables are dropped") {
+    std::unique_ptr<SatBackend> backend = make_sat_backend(SAT_MINISAT_SIMP);
+
+    // 3 occurs once each way and is not frozen: preprocessing eliminates it
+    std::vector<std::vector<int>> clauses = {{1, 3}, {2, -3}};
+    for(const std::vector<int>& c: clauses) {
+        for(int l: c)
+            backend->add(l);
+        backend->add(0);
+    }
+    backend->freeze(1);
+    backend->freeze(2);
+    backend->preprocess();
+
+    // together the first two would refute the CNF; only the third may come
+    // in, and the literal after the eliminated one must not stall the scan
+    bool first = true;
+    backend->set_import([&first](std::vector<int>& clauses) {
+        if(first)
+            clauses.insert(clauses.end(), {3, -2, 0, -3, -2, 0, -1, 0});
+        first = false;
+    });
+
+    CHECK(backend->solve() == 10);
+    CHECK(!first);
+    CHECK(backend->val(1) == -1);
+    CHECK(backend->val(2) == 2);
+}
+
+TEST_CASE("portfolio_solve answers like brute force") {
+    unsigned seed = 49;
+    for(int round = 0; round < 100; round++) {
+        int n = 3 + rand_r(&seed) % 6;
+        std::vector<std::vector<int>> clauses = random_cnf(n, rand_r(&seed) % 24, 3, seed);
+        bool expected = brute_force_sat(n, clauses, std::vector<int>());
+        INFO("round " << round);
+
+        std::vector<std::unique_ptr<SatBackend>> backends;
+        for(int i = 0; i < 3; i++) {
+            backends.push_back(make_sat_backend(i == 2 ? SAT_MINISAT_SIMP : SAT_MINISAT));
+            backends.back()->diversify(i);
+            for(const std::vector<int>& c: clauses) {
+                for(int l: c)
+                    backends.back()->add(l);
+                backends.back()->add(0);
+            }
+        }
+
+        int status = 0;
+        int winner = portfolio_solve(backends, status);
+        REQUIRE(winner >= 0);
+        CHECK(status == (expected ? 10 : 20));
+        if(status == 10) {
+            for(const std::vector<int>& c: clauses) {
+                bool any = false;
+                for(int l: c)
+                    any = any || backends[winner]->val(l) == l;
+                CHECK(any);
+            }
+        }
+    }
+}
+
+TEST_CASE("cube_solve answers like brute force") {
+    unsigned seed = 50;
+    for(int round = 0; round < 100; round++) {
+        int n = 3 + rand_r(&seed) % 6;
+        std::vector<std::vector<int>> clauses = random_cnf(n, rand_r(&seed) % 24, 3, seed);
+        bool expected = brute_force_sat(n, clauses, std::vector<int>());
+        INFO("round " << round);
+
+        // every way of setting the first depth variables
+        int depth = 1 + rand_r(&seed) % 3;
+        std::vector<std::vector<int>> cubes;
+        for(int set = 0; set < (1 << depth); set++) {
+            std::vector<int> cube;
+            for(int v = 1; v <= depth; v++)
+                cube.push_back((set >> (v - 1)) & 1 ? v : -v);
+            cubes.push_back(cube);
+        }
+
+        std::vector<std::unique_ptr<SatBackend>> backends;
+        for(int i = 0; i < 2; i++) {
+            backends.push_back(make_sat_backend(SAT_MINISAT));
+            for(const std::vector<int>& c: clauses) {
+                for(int l: c)
+                    backends.back()->add(l);
+                backends.back()->add(0);
+            }
+        }
+
+        int status = 0;
+        int winner = cube_solve(backends, cubes, status);
+        CHECK(status == (expected ? 10 : 20));
+        CHECK((winner >= 0) == expected);
+        if(winner >= 0) {
+            for(const std::vector<int>& c: clauses) {
+                bool any = false;
+                for(int l: c)
+                    any = any || backends[winner]->val(l) == l;
+                CHECK(any);
+            }
+        }
+    }
+}
+
+TEST_CASE("vc_cnf_sat is exact with cube-and-conquer") {
+    unsigned seed = 51;
+    for(int round = 0; round < 60; round++) {
+        int n = 2 + rand_r(&seed) % 8;
+        Graph g = random_graph(n, (rand_r(&seed) % 100) / 100.0, seed);
+        int opt = brute_force_cover(g).size();
+        INFO("round " << round << ", " << n << " vertices, optimum " << opt);
+
+        cnf_options cnf;
+        cnf.cube_depth = 1 + round % 4;
+        cnf.cardinality = round % 2 ? CARD_SLOTS : CARD_SEQUENTIAL;
+        for(int k = std::max(0, opt - 1); k <= opt + 1; k++) {
+            VCSolver solver(cnf);
+            std::pair<bool, std::vector<int>> result = solver.vc_cnf_sat(g, k);
+            CHECK(result.first == (k >= opt));
+            if(result.first) {
+                CHECK(is_cover(g, result.second));
+                CHECK((int)result.second.size() <= k);
+            }
+        }
+    }
+}
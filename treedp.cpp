@@ -0,0 +1,216 @@
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <set>
+#include <vector>
+#include <utility>
+
+#include "treedp.hpp"
+
+TreewidthSolver::TreewidthSolver(const Graph& g, int max_width) {
+
+    this->n = g.vs();
+    this->limit = std::min(max_width, 24);
+
+    int **m = g.adjmat();
+    this->adj.resize(this->n);
+    for(int v1 = 0; v1 < this->n; v1++)
+        for(int v2 = 0; v2 < this->n; v2++)
+            if(m[v1][v2] == 1)
+                this->adj[v1].insert(v2);
+
+    this->tw = this->eliminate(false, this->order, this->later);
+
+    // min-fill finds narrower decompositions but costs far more per step
+    if(this->tw == -1 && this->n <= 300)
+        this->tw = this->eliminate(true, this->order, this->later);
+
+    if(this->tw == -1)
+        return;
+
+    this->must.resize(this->n, 0);
+    for(int v = 0; v < this->n; v++)
+        for(size_t i = 0; i < this->later[v].size(); i++)
+            if(this->adj[v].count(this->later[v][i]) == 1)
+                this->must[v] |= 1u << i;
+}
+
+int TreewidthSolver::eliminate(bool min_fill, std::vector<int>& order, std::vector<std::vector<int>>& later) const {
+
+    std::vector<std::set<int>> filled = this->adj;
+    std::vector<bool> done(this->n, false);
+
+    order.clear();
+    later.assign(this->n, std::vector<int>());
+
+    auto fill_in = [&](int v) {
+        int fill = 0;
+        for(auto a = filled[v].begin(); a != filled[v].end(); ++a)
+            for(auto b = std::next(a); b != filled[v].end(); ++b)
+                if(filled[*a].count(*b) == 0)
+                    fill++;
+        return fill;
+    };
+
+    // min-degree keeps a lazy heap; min-fill rescans, it is only used on small graphs
+    typedef std::pair<int, int> entry;
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> heap;
+    for(int v = 0; v < this->n; v++)
+        heap.push(std::make_pair(filled[v].size(), v));
+
+    int width = 0;
+    for(int step = 0; step < this->n; step++) {
+
+        pthread_testcancel();
+
+        int v = -1;
+        if(min_fill) {
+            int best = INT_MAX;
+            for(int u = 0; u < this->n; u++) {
+                if(done[u])
+                    continue;
+                int f = fill_in(u);
+                if(f < best || (f == best && filled[u].size() < filled[v].size())) {
+                    best = f;
+                    v = u;
+                }
+            }
+        } else {
+            while(v == -1) {
+                entry e = heap.top();
+                heap.pop();
+                if(!done[e.second] && (int)filled[e.second].size() == e.first)
+                    v = e.second;
+            }
+        }
+
+        if((int)filled[v].size() > this->limit)
+            return -1;
+        width = std::max(width, (int)filled[v].size());
+
+        // the remaining neighbors of v become a clique
+        for(int a: filled[v]) {
+            filled[a].erase(v);
+            for(int b: filled[v])
+                if(a != b)
+                    filled[a].insert(b);
+        }
+
+        later[v].assign(filled[v].begin(), filled[v].end());
+        for(int a: filled[v])
+            heap.push(std::make_pair(filled[a].size(), a));
+
+        filled[v].clear();
+        done[v] = true;
+        order.push_back(v);
+    }
+
+    return width;
+}
+
+std::vector<int> TreewidthSolver::solve() const {
+
+    // Messages are passed along the elimination tree: the parent of v is
+    // the first vertex of later[v] to be eliminated, and later[c] of every
+    // child c lies within v + later[v]. cost[v][a] is the smallest cover of
+    // the vertices in v's subtree given assignment a (bit i: later[v][i] is
+    // in the cover), and choice[v][a] says whether v itself is then taken.
+    std::vector<int> position(this->n);
+    for(int i = 0; i < this->n; i++)
+        position[this->order[i]] = i;
+
+    std::vector<std::vector<int>> children(this->n);
+    for(int v: this->order) {
+        if(this->later[v].empty())
+            continue;
+
+        int parent = this->later[v][0];
+        for(int u: this->later[v])
+            if(position[u] < position[parent])
+                parent = u;
+        children[parent].push_back(v);
+    }
+
+    std::vector<std::vector<int>> cost(this->n);
+    std::vector<std::vector<bool>> choice(this->n);
+
+    for(int v: this->order) {
+
+        pthread_testcancel();
+
+        const std::vector<int>& scope = this->later[v];
+        size_t d = scope.size();
+
+        // where each child's scope variables sit in (scope bits, v as bit d)
+        std::vector<std::vector<int>> maps;
+        for(int c: children[v]) {
+            std::vector<int> map;
+            for(int u: this->later[c]) {
+                if(u == v) {
+                    map.push_back(d);
+                } else {
+                    for(size_t i = 0; i < d; i++)
+                        if(scope[i] == u)
+                            map.push_back(i);
+                }
+            }
+            maps.push_back(map);
+        }
+
+        cost[v].assign((size_t)1 << d, 0);
+        choice[v].assign((size_t)1 << d, false);
+
+        for(unsigned a = 0; a < ((unsigned)1 << d); a++) {
+
+            int best = INT_MAX;
+            for(unsigned x = 0; x <= 1; x++) {
+
+                // leaving v out needs every later neighbor in the cover
+                if(x == 0 && (a & this->must[v]) != this->must[v])
+                    continue;
+
+                unsigned full = a | (x << d);
+                int total = x;
+                for(size_t c = 0; c < children[v].size(); c++) {
+                    unsigned index = 0;
+                    for(size_t i = 0; i < maps[c].size(); i++)
+                        index |= ((full >> maps[c][i]) & 1) << i;
+                    total += cost[children[v][c]][index];
+                }
+
+                if(total < best) {
+                    best = total;
+                    choice[v][a] = x;
+                }
+            }
+
+            cost[v][a] = best;
+        }
+
+        for(int c: children[v])
+            std::vector<int>().swap(cost[c]);
+    }
+
+    // replay the choices from the roots down
+    std::vector<bool> in(this->n, false);
+    for(auto it = this->order.rbegin(); it != this->order.rend(); ++it) {
+        int v = *it;
+        unsigned a = 0;
+        for(size_t i = 0; i < this->later[v].size(); i++)
+            if(in[this->later[v][i]])
+                a |= 1u << i;
+        in[v] = choice[v][a];
+    }
+
+    std::vector<int> cover;
+    for(int v = 0; v < this->n; v++)
+        if(in[v])
+            cover.push_back(v);
+
+    return cover;
+}
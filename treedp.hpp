@@ -0,0 +1,44 @@
+
+#ifndef _TREEDP_HPP
+#define _TREEDP_HPP
+
+#include <set>
+#include <vector>
+
+#include "graph.hpp"
+
+// Exact minimum vertex cover by dynamic programming over a tree
+// decomposition. The decomposition comes from a greedy elimination ordering
+// (min-degree, then min-fill when that is too wide); the bag of a vertex is
+// itself plus its neighbors eliminated after it. The DP keeps one table of
+// 2^|bag| entries per vertex, so it is only attempted up to a width limit.
+class TreewidthSolver {
+
+    private:
+
+        int n;
+        int limit;
+        std::vector<std::set<int>> adj;
+
+        std::vector<int> order;
+        std::vector<std::vector<int>> later;
+        int tw;
+
+        // bit i set when later[v][i] is an edge of the graph, not a fill edge
+        std::vector<unsigned> must;
+
+        int eliminate(bool min_fill, std::vector<int>& order, std::vector<std::vector<int>>& later) const;
+
+    public:
+
+        TreewidthSolver(const Graph& g, int max_width);
+
+        // width of the decomposition found, -1 if it exceeds the limit
+        int width() const {
+            return this->tw;
+        }
+
+        std::vector<int> solve() const;
+};
+
+#endif